@@ -592,21 +592,21 @@ void RSDK::LoadSfx(char *filename, uint8 plays, uint8 scope)
         sfxList[id].fileName[sizeof(sfxList[id].fileName) - 1] = '\0';
     }
 #else
-    FileInfo info;
-    InitFileInfo(&info);
-
-    char fullFilePath[0x80];
-    sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/SoundFX/%s", filename);
-
     RETRO_HASH_MD5(hash);
     GEN_HASH_MD5(filename, hash);
 
-    if (LoadFile(&info, fullFilePath, FMODE_RB)) {
-        HASH_COPY_MD5(sfxList[slot].hash, hash);
-        sfxList[slot].scope              = scope;
-        sfxList[slot].maxConcurrentPlays = plays;
+    // Make sure filename isn't already loaded
+    for (uint32 i = 0; i < SFX_COUNT; ++i) {
+        if (sfxList[i].scope != SCOPE_NONE && HASH_MATCH_MD5(sfxList[i].hash, hash))
+            return;
+    }
+
+    for (uint32 i = 0; i < SFX_COUNT; ++i) {
+        if (sfxList[i].scope == SCOPE_NONE) {
+            LoadSfxToSlot(filename, i, plays, scope);
+            return;
+        }
     }
-    CloseFile(&info);
 #endif
 }
 
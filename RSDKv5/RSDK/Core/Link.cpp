@@ -76,6 +76,7 @@ void RSDK::SetupFunctionTables()
 
     CalculateTrigAngles();
     GenerateBlendLookupTable();
+    InitTileRowKernels();
     InitSystemSurfaces();
 
     memset(RSDKFunctionTable, 0, sizeof(RSDKFunctionTable));
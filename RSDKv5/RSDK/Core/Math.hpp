@@ -1,6 +1,10 @@
 #ifndef MATH_H
 #define MATH_H
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace RSDK
 {
 
@@ -25,6 +29,37 @@ struct Vector2 {
 
 #define MEM_ZERO(x) memset(&(x), 0, sizeof((x)))
 
+// index of the lowest set bit, value must not be 0
+inline int32 CountTrailingZeros(uint32 value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(value);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return (int32)index;
+#else
+    int32 count = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// number of set bits in value
+inline int32 CountSetBits(uint32 value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(value);
+#else
+    value = value - ((value >> 1) & 0x55555555);
+    value = (value & 0x33333333) + ((value >> 2) & 0x33333333);
+    return (int32)((((value + (value >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+#endif
+}
+
 extern int32 sin1024LookupTable[0x400];
 extern int32 cos1024LookupTable[0x400];
 extern int32 tan1024LookupTable[0x400];
@@ -195,6 +195,18 @@ void RSDK::InitModAPI(bool32 getVersion)
     ADD_MOD_FUNCTION(ModTable_FindRWallPosition, FindRWallPosition);
     ADD_MOD_FUNCTION(ModTable_CopyCollisionMask, CopyCollisionMask);
     ADD_MOD_FUNCTION(ModTable_GetCollisionInfo, GetCollisionInfo);
+
+    // Objects/Entities (Part 2)
+    ADD_MOD_FUNCTION(ModTable_GetEntitiesInArea, GetEntitiesInArea);
+    ADD_MOD_FUNCTION(ModTable_SetClassParallelUpdate, SetClassParallelUpdate);
+
+    // Collision (Part 2)
+    ADD_MOD_FUNCTION(ModTable_CheckObjectCollisionTouchList, CheckObjectCollisionTouchList);
+
+    // Scene
+    ADD_MOD_FUNCTION(ModTable_CaptureSceneSnapshot, CaptureSceneSnapshot);
+    ADD_MOD_FUNCTION(ModTable_RestoreSceneSnapshot, RestoreSceneSnapshot);
+    ADD_MOD_FUNCTION(ModTable_PreloadScene, PreloadScene);
 #endif
 
     superLevels.clear();
@@ -448,7 +460,16 @@ void RSDK::UnloadMods()
     for (ModInfo &mod : modList) {
         if (mod.unloadMod)
             mod.unloadMod();
+    }
 
+    // Clear storage, before the mod libraries are closed since entries can have their handles in a mod's globals
+    ResetStorage(DATASET_STG);
+    DefragmentAndGarbageCollectStorage(DATASET_MUS);
+    dataStorage[DATASET_SFX].usedStorage = 0;
+    dataStorage[DATASET_STR].usedStorage = 0;
+    ResetStorage(DATASET_TMP);
+
+    for (ModInfo &mod : modList) {
         for (Link::Handle &handle : mod.modLogicHandles) {
             Link::Close(handle);
         }
@@ -483,13 +504,6 @@ void RSDK::UnloadMods()
 
     customUserFileDir[0] = 0;
 
-    // Clear storage
-    dataStorage[DATASET_STG].usedStorage = 0;
-    DefragmentAndGarbageCollectStorage(DATASET_MUS);
-    dataStorage[DATASET_SFX].usedStorage = 0;
-    dataStorage[DATASET_STR].usedStorage = 0;
-    dataStorage[DATASET_TMP].usedStorage = 0;
-
 #if RETRO_REV02
     // Clear out any userDBs
     if (SKU::userDBStorage)
@@ -138,6 +138,18 @@ enum ModFunctionTableIDs {
     ModTable_FindRWallPosition,
     ModTable_CopyCollisionMask,
     ModTable_GetCollisionInfo,
+
+    // Objects/Entities (Part 2)
+    ModTable_GetEntitiesInArea,
+    ModTable_SetClassParallelUpdate,
+
+    // Collision (Part 2)
+    ModTable_CheckObjectCollisionTouchList,
+
+    // Scene
+    ModTable_CaptureSceneSnapshot,
+    ModTable_RestoreSceneSnapshot,
+    ModTable_PreloadScene,
 #endif
 
     ModTable_Count
@@ -354,6 +366,12 @@ inline void *GetSpriteSurface(uint16 id)
 {
     if (id >= SURFACE_COUNT)
         return NULL;
+
+#if !RETRO_USE_ORIGINAL_CODE
+    // mods can edit the pixels through this, so the span table can't be trusted anymore
+    gfxSurface[id].spanTable     = NULL;
+    gfxSurface[id].spanTableSize = 0;
+#endif
     return &gfxSurface[id];
 }
 inline uint16 *GetPaletteBank(uint8 id)
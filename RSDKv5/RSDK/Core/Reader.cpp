@@ -12,6 +12,14 @@ char RSDK::gameLogicName[0x200];
 
 bool32 RSDK::useDataPack = false;
 
+#if !RETRO_USE_ORIGINAL_CODE
+PreloadedFile RSDK::preloadedFiles[PRELOADFILE_COUNT];
+int32 RSDK::preloadedFileHits = 0;
+
+// set while PreloadFile has LoadFile open the file, so LoadFile can fill in the resolved path
+static PreloadedFile *openingPreload = NULL;
+#endif
+
 #if RETRO_REV0U
 void RSDK::DetectEngineVersion()
 {
@@ -300,6 +308,15 @@ bool32 RSDK::LoadFile(FileInfo *info, const char *filename, uint8 fileMode)
     }
 #endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+    if (fileMode == FMODE_RB) {
+        if (openingPreload)
+            strcpy(openingPreload->name, fullFilePath);
+        else if (OpenPreloadedFile(info, fullFilePath))
+            return true;
+    }
+#endif
+
     if (!info->externalFile && fileMode == FMODE_RB && useDataPack) {
         return OpenDataFile(info, filename);
     }
@@ -462,3 +479,110 @@ void RSDK::SkipBytes(FileInfo *info, int32 size)
         }
     }
 }
+
+#if !RETRO_USE_ORIGINAL_CODE
+void RSDK::PreloadFile(const char *filename)
+{
+    int32 slot = -1;
+    for (int32 f = 0; f < PRELOADFILE_COUNT; ++f) {
+        if (!preloadedFiles[f].buffer) {
+            if (slot < 0)
+                slot = f;
+        }
+        else if (!strcmp(preloadedFiles[f].request, filename)) {
+            return;
+        }
+    }
+
+    if (slot < 0)
+        return;
+
+    PreloadedFile *file = &preloadedFiles[slot];
+    InitFileInfo(&file->info);
+    sprintf_s(file->request, sizeof(file->request), "%s", filename);
+
+    openingPreload = file;
+    bool32 opened  = LoadFile(&file->info, filename, FMODE_RB);
+    openingPreload = NULL;
+    if (!opened)
+        return;
+
+    // this is in stage storage so it can sit through the next LoadSceneFolder's garbage collection
+    AllocateStorage((void **)&file->buffer, MAX(file->info.fileSize, 1), DATASET_STG, false);
+    if (!file->buffer) {
+        CloseFile(&file->info);
+        return;
+    }
+
+    file->readSize = 0;
+}
+
+bool32 RSDK::ProcessFilePreloads(int32 budget)
+{
+    bool32 pending = false;
+
+    for (int32 f = 0; f < PRELOADFILE_COUNT; ++f) {
+        PreloadedFile *file = &preloadedFiles[f];
+        if (!file->buffer || !file->info.file)
+            continue;
+
+        int32 size = MIN(budget, file->info.fileSize - file->readSize);
+        if (size > 0) {
+            ReadBytes(&file->info, &file->buffer[file->readSize], size);
+            file->readSize += size;
+            budget -= size;
+        }
+
+        if (file->readSize >= file->info.fileSize)
+            CloseFile(&file->info);
+        else
+            pending = true;
+    }
+
+    return pending;
+}
+
+bool32 RSDK::OpenPreloadedFile(FileInfo *info, const char *filename)
+{
+    for (int32 f = 0; f < PRELOADFILE_COUNT; ++f) {
+        PreloadedFile *file = &preloadedFiles[f];
+        if (!file->buffer || strcmp(file->name, filename))
+            continue;
+
+        if (file->info.file) {
+            ReadBytes(&file->info, &file->buffer[file->readSize], file->info.fileSize - file->readSize);
+            file->readSize = file->info.fileSize;
+            CloseFile(&file->info);
+        }
+
+        // the copy's already decrypted, so it's read like any other buffered file
+        info->usingFileBuffer = true;
+        info->file            = (FileIO *)file->buffer;
+        info->fileBuffer      = file->buffer;
+        info->fileSize        = file->info.fileSize;
+        info->readPos         = 0;
+        info->fileOffset      = 0;
+        info->encrypted       = false;
+
+        ++preloadedFileHits;
+        PrintLog(PRINT_NORMAL, "Loaded preloaded file %s", filename);
+        return true;
+    }
+
+    return false;
+}
+
+void RSDK::ReleasePreloadedFiles()
+{
+    for (int32 f = 0; f < PRELOADFILE_COUNT; ++f) {
+        PreloadedFile *file = &preloadedFiles[f];
+
+        CloseFile(&file->info);
+        if (file->buffer)
+            RemoveStorageEntry((void **)&file->buffer);
+
+        file->request[0] = 0;
+        file->name[0]    = 0;
+    }
+}
+#endif
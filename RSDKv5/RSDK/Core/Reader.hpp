@@ -115,6 +115,31 @@ inline void InitFileInfo(FileInfo *info)
 
 bool32 LoadFile(FileInfo *info, const char *filename, uint8 fileMode);
 
+#if !RETRO_USE_ORIGINAL_CODE
+// files that get read ahead of time (a bit every frame) & then handed to LoadFile from memory, see PreloadScene
+#define PRELOADFILE_COUNT (8)
+// how much of the queued files gets read each frame
+#define PRELOADFILE_FRAME_BUDGET (0x8000)
+
+struct PreloadedFile {
+    char request[0x100]; // the name PreloadFile was called with, so repeated requests don't take up more slots
+    char name[0x100];    // the path LoadFile resolved it to, so mod changes don't get a stale copy
+    FileInfo info;
+    uint8 *buffer;
+    int32 readSize;
+};
+
+extern PreloadedFile preloadedFiles[PRELOADFILE_COUNT];
+extern int32 preloadedFileHits;
+
+void PreloadFile(const char *filename);
+// reads up to budget bytes of whatever's queued, returns true while there's still more to read
+bool32 ProcessFilePreloads(int32 budget);
+// opens a copy from preloadedFiles if there is one, finishing the read first if it's still in progress
+bool32 OpenPreloadedFile(FileInfo *info, const char *filename);
+void ReleasePreloadedFiles();
+#endif
+
 inline void CloseFile(FileInfo *info)
 {
     if (!info->usingFileBuffer && info->file)
@@ -6,6 +6,8 @@ using namespace RSDK;
 #include "Legacy/RetroEngineLegacy.cpp"
 #endif
 
+#include "Threading.cpp"
+
 LogicLinkHandle RSDK::linkGameLogic = NULL;
 
 Link::Handle gameLogicHandle = NULL;
@@ -15,6 +17,10 @@ Link::Handle gameLogicHandle = NULL;
 #include <unistd.h>
 #endif
 
+#if !RETRO_USE_ORIGINAL_CODE && RETRO_PLATFORM != RETRO_PS2
+#include <chrono>
+#endif
+
 int32 *RSDK::globalVarsPtr = NULL;
 #if RETRO_REV0U
 void (*RSDK::globalVarsInitCB)(void *globals) = NULL;
@@ -22,6 +28,30 @@ void (*RSDK::globalVarsInitCB)(void *globals) = NULL;
 
 RetroEngine RSDK::engine = RetroEngine();
 
+#if !RETRO_USE_ORIGINAL_CODE
+int64 RSDK::GetEngineTime()
+{
+#if RETRO_PLATFORM == RETRO_PS2
+    // nothing else runs alongside the game, so cpu time is as good as wall time here
+    return (int64)clock() * 1000000 / CLOCKS_PER_SEC;
+#else
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void RSDK::RunBenchmarks()
+{
+    if (engine.benchmarks & BENCHMARK_TILEROWS)
+        BenchmarkTileRows();
+
+    if (engine.benchmarks & BENCHMARK_DRAWLIST)
+        BenchmarkDrawListSort();
+
+    if (engine.benchmarks & BENCHMARK_BLITTERS)
+        BenchmarkSpriteBlitters();
+}
+#endif
+
 int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
 {
     ParseArguments(argc, argv);
@@ -33,6 +63,11 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
     if (InitStorage()) {
         SKU::InitUserCore();
         LoadSettingsINI();
+#if RETRO_USE_THREADS
+        // the main thread takes a share of every job, so it counts as one of the render threads
+        if (customSettings.renderThreads > 1)
+            InitWorkerThreads(customSettings.renderThreads - 1);
+#endif
 
 #if !RETRO_USE_ORIGINAL_CODE
         // temp fix till i properly figure out what exactly went wrong here
@@ -88,6 +123,10 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
         }
 
         InitEngine();
+#if !RETRO_USE_ORIGINAL_CODE
+        if (engine.benchmarks)
+            RunBenchmarks();
+#endif
 #if RETRO_USE_MOD_LOADER
         // we confirmed the game actually is valid & running, lets start some callbacks
         videoSettings.shaderID = shader;
@@ -211,8 +250,7 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
                         globalVarsPtr    = NULL;
                         globalVarsInitCB = NULL;
 
-                        dataStorage[DATASET_STG].entryCount  = 0;
-                        dataStorage[DATASET_STG].usedStorage = 0;
+                        ResetStorage(DATASET_STG);
                         dataStorage[DATASET_SFX].entryCount  = 0;
                         dataStorage[DATASET_SFX].usedStorage = 0;
 
@@ -271,6 +309,12 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
 #else
                     ProcessEngine();
 #endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+                    ProcessFilePreloads(PRELOADFILE_FRAME_BUDGET);
+                    UpdateStorageGC();
+                    ProcessSceneSnapshotRestore();
+#endif
                 }
 
 #if RETRO_PLATFORM == RETRO_ANDROID
@@ -323,6 +367,9 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
 
     // Shutdown
 
+#if RETRO_USE_THREADS
+    ReleaseWorkerThreads();
+#endif
     ReleaseInputDevices();
     AudioDevice::Release();
     RenderDevice::Release(false);
@@ -583,6 +630,20 @@ void RSDK::ProcessEngine()
     }
 }
 
+#if RETRO_USE_STORAGE_SIMULATION
+// limits are given in kb but stored in bytes, anything that doesn't fit is ignored rather than wrapping around
+static uint32 ParseStorageLimit(const char *arg, const char *name)
+{
+    int64 size = atoll(arg) * 1024;
+    if (size < 0 || size > 0xFFFFFFFF) {
+        PrintLog(PRINT_NORMAL, "Ignoring %s%s, it must be between 0 and %u kb", name, arg, 0xFFFFFFFF / 1024);
+        return 0;
+    }
+
+    return (uint32)size;
+}
+#endif
+
 void RSDK::ParseArguments(int32 argc, char *argv[])
 {
     memset(currentSceneFolder, 0, sizeof(currentSceneFolder));
@@ -591,6 +652,11 @@ void RSDK::ParseArguments(int32 argc, char *argv[])
     sceneInfo.filter = 0;
 #endif
 
+#if RETRO_USE_STORAGE_SIMULATION
+    // failevery= counts every dataset unless failsets= says otherwise, even if the sets it names don't match anything
+    bool32 failSetsGiven = false;
+#endif
+
     for (int32 a = 0; a < argc; ++a) {
         const char *find = "";
 
@@ -623,6 +689,70 @@ void RSDK::ParseArguments(int32 argc, char *argv[])
         }
 #endif
 
+#if RETRO_RENDERDEVICE_HEADLESS
+        find = strstr(argv[a], "dumpframes=");
+        if (find)
+            RenderDevice::dumpInterval = atoi(find + 11);
+
+        find = strstr(argv[a], "dumpformat=raw");
+        if (find)
+            RenderDevice::dumpFormat = HEADLESS_DUMP_RAW;
+
+        find = strstr(argv[a], "framelimit=");
+        if (find)
+            RenderDevice::frameLimit = atoi(find + 11);
+
+        find = strstr(argv[a], "uncapped=true");
+        if (find)
+            RenderDevice::uncapped = true;
+#endif
+
+#if RETRO_USE_STORAGE_SIMULATION
+        // sizes are in kb, e.g. "memlimit=16384 stglimit=4096 failevery=50 failsets=stg,tmp"
+        find = strstr(argv[a], "memlimit=");
+        if (find)
+            storageSimulation.totalLimit = ParseStorageLimit(find + 9, "memlimit=");
+
+        const char *setNames[] = { "stglimit=", "muslimit=", "sfxlimit=", "strlimit=", "tmplimit=" };
+        for (int32 s = 0; s < DATASET_MAX; ++s) {
+            find = strstr(argv[a], setNames[s]);
+            if (find)
+                storageSimulation.setLimits[s] = ParseStorageLimit(find + 9, setNames[s]);
+        }
+
+        find = strstr(argv[a], "failevery=");
+        if (find)
+            storageSimulation.failEvery = atoi(find + 10);
+
+        find = strstr(argv[a], "failsets=");
+        if (find) {
+            failSetsGiven              = true;
+            storageSimulation.failSets = 0;
+            for (int32 s = 0; s < DATASET_MAX; ++s) {
+                char name[4];
+                memcpy(name, setNames[s], 3);
+                name[3] = 0;
+                if (strstr(find + 9, name))
+                    storageSimulation.failSets |= 1 << s;
+            }
+
+            if (!storageSimulation.failSets)
+                PrintLog(PRINT_NORMAL, "failsets=%s doesn't name any dataset, no allocations will be failed", find + 9);
+        }
+#endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+        // e.g. "bench=tiles,drawlist,blit" or "bench=all", the results are logged before the first scene loads
+        find = strstr(argv[a], "bench=");
+        if (find) {
+            const char *benchNames[] = { "tiles", "drawlist", "blit" };
+            for (int32 b = 0; b < (int32)(sizeof(benchNames) / sizeof(benchNames[0])); ++b) {
+                if (strstr(find + 6, benchNames[b]) || strstr(find + 6, "all"))
+                    engine.benchmarks |= 1 << b;
+            }
+        }
+#endif
+
 #if !RETRO_DISABLE_LOG
         find = strstr(argv[a], "console=true");
         if (find) {
@@ -631,6 +761,11 @@ void RSDK::ParseArguments(int32 argc, char *argv[])
         }
 #endif
     }
+
+#if RETRO_USE_STORAGE_SIMULATION
+    if (storageSimulation.failEvery && !failSetsGiven)
+        storageSimulation.failSets = (1 << DATASET_MAX) - 1;
+#endif
 }
 
 void RSDK::InitEngine()
@@ -1203,6 +1338,9 @@ void RSDK::InitGameLink()
     editableVarCount = 0;
     foreachStackPtr  = foreachStackList;
     currentMod       = NULL;
+#if !RETRO_USE_ORIGINAL_CODE
+    RebuildEntityClassIndex();
+#endif
 #endif
 
 #if RETRO_REV0U
@@ -171,6 +171,8 @@ enum GameRegions {
 #define RETRO_RENDERDEVICE_GLFW (0)
 #define RETRO_RENDERDEVICE_VK   (0)
 #define RETRO_RENDERDEVICE_EGL  (0)
+// renders into screen memory only, no window or gpu needed
+#define RETRO_RENDERDEVICE_HEADLESS (0)
 
 // ============================
 // AUDIO DEVICE BACKENDS
@@ -203,7 +205,10 @@ enum GameRegions {
 #define RETRO_INPUTDEVICE_SDL2   (0)
 #define RETRO_INPUTDEVICE_GLFW   (0)
 #define RETRO_INPUTDEVICE_PDBOAT (0)
-#define RETRO_INPUTDEVICE_PS2 (1)
+// the pad driver needs the ps2sdk headers (tamtypes.h), so it can only default on for the PS2 (which also enables it below)
+#ifndef RETRO_INPUTDEVICE_PS2
+#define RETRO_INPUTDEVICE_PS2 (RETRO_PLATFORM == RETRO_PS2)
+#endif
 
 // ============================
 // USER CORE BACKENDS
@@ -261,6 +266,27 @@ enum GameRegions {
 #define RETRO_DISABLE_LOG (0)
 #endif
 
+// Cross-checks the per-class entity index against a full scan of every entity slot each frame, only useful when working on the engine itself
+#ifndef RETRO_VALIDATE_ENTITY_INDEX
+#define RETRO_VALIDATE_ENTITY_INDEX (0)
+#endif
+
+// Enables the worker thread pool used for parallel rendering (needs std::thread, which the PS2 toolchain doesn't give us)
+#ifndef RETRO_USE_THREADS
+#define RETRO_USE_THREADS (!RETRO_USE_ORIGINAL_CODE && RETRO_PLATFORM != RETRO_PS2)
+#endif
+
+// Tracks peaks, size histograms, GC time & the call sites behind every storage allocation, shown in the dev menu & dumped to storage.csv
+// opt in only: it costs a call site per entry & some bookkeeping on every allocation, which release builds don't need
+#ifndef RETRO_USE_STORAGE_TELEMETRY
+#define RETRO_USE_STORAGE_TELEMETRY (0)
+#endif
+
+// Lets the command line shrink the storage limits & make allocations fail on purpose, to try out low memory targets on a desktop
+#ifndef RETRO_USE_STORAGE_SIMULATION
+#define RETRO_USE_STORAGE_SIMULATION (!RETRO_USE_ORIGINAL_CODE && RETRO_PLATFORM == RETRO_LINUX)
+#endif
+
 // ============================
 // PLATFORM INIT
 // ============================
@@ -368,8 +394,12 @@ enum GameRegions {
 #define RETRO_INPUTDEVICE_GLFW (1)
 #endif
 
+#elif defined(RSDK_USE_HEADLESS)
+#undef RETRO_RENDERDEVICE_HEADLESS
+#define RETRO_RENDERDEVICE_HEADLESS (1)
+
 #else
-#error RSDK_USE_SDL2, RSDK_USE_OGL or RSDK_USE_VK must be defined.
+#error RSDK_USE_SDL2, RSDK_USE_OGL, RSDK_USE_VK or RSDK_USE_HEADLESS must be defined.
 #endif //! RSDK_USE_SDL2
 
 #elif RETRO_PLATFORM == RETRO_SWITCH
@@ -581,12 +611,47 @@ extern "C" {
 
 #include <theora/theoradec.h>
 
+#if RETRO_USE_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#endif
+
+// ============================
+// SIMD
+// ============================
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RETRO_USE_SSE2 (1)
+#include <emmintrin.h>
+#else
+#define RETRO_USE_SSE2 (0)
+#endif
+
+#if defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#define RETRO_USE_NEON (1)
+#include <arm_neon.h>
+#else
+#define RETRO_USE_NEON (0)
+#endif
+
+// checks the SIMD blend kernels against blendLookupTable/subtractLookupTable after they're generated, on by default in debug builds
+#ifndef RETRO_VALIDATE_BLEND_KERNELS
+#if !defined(NDEBUG) && (RETRO_USE_SSE2 || RETRO_USE_NEON)
+#define RETRO_VALIDATE_BLEND_KERNELS (1)
+#else
+#define RETRO_VALIDATE_BLEND_KERNELS (0)
+#endif
+#endif
+
 // ============================
 // ENGINE INCLUDES
 // ============================
 
 #include "RSDK/Storage/Storage.hpp"
 #include "RSDK/Core/Math.hpp"
+#include "RSDK/Core/Threading.hpp"
 #include "RSDK/Storage/Text.hpp"
 #include "RSDK/Core/Reader.hpp"
 #include "RSDK/Graphics/Animation.hpp"
@@ -629,6 +694,15 @@ extern "C" {
 namespace RSDK
 {
 
+#if !RETRO_USE_ORIGINAL_CODE
+// micro-benchmarks that can be run with "bench=", see ParseArguments for their names
+enum BenchmarkFlags {
+    BENCHMARK_TILEROWS = 1 << 0,
+    BENCHMARK_DRAWLIST = 1 << 1,
+    BENCHMARK_BLITTERS = 1 << 2,
+};
+#endif
+
 struct RetroEngine {
     RetroEngine() {}
 
@@ -640,6 +714,9 @@ struct RetroEngine {
 
     bool32 devMenu        = false;
     bool32 consoleEnabled = false;
+#if !RETRO_USE_ORIGINAL_CODE
+    uint8 benchmarks = 0;
+#endif
 
     bool32 confirmFlip = false; // swaps A/B, used for nintendo and etc controllers
     bool32 XYFlip      = false; // swaps X/Y, used for nintendo and etc controllers
@@ -709,6 +786,14 @@ void ParseArguments(int32 argc, char *argv[]);
 void InitEngine();
 void StartGameObjects();
 
+#if !RETRO_USE_ORIGINAL_CODE
+// wall clock time in microseconds, for timing the things that get logged (scene loads, storage gc etc)
+int64 GetEngineTime();
+
+// runs & logs every benchmark set in engine.benchmarks
+void RunBenchmarks();
+#endif
+
 #if RETRO_USE_MOD_LOADER
 void LoadGameXML(bool pal = false);
 void LoadXMLWindowText(const tinyxml2::XMLElement *gameElement);
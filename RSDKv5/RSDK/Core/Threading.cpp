@@ -0,0 +1,113 @@
+#if RETRO_USE_THREADS
+
+int32 RSDK::workerThreadCount = 0;
+
+static std::thread workerThreads[WORKERTHREAD_COUNT];
+static std::mutex workerMutex;
+static std::condition_variable workerStartCV;
+static std::condition_variable workerDoneCV;
+
+static WorkerJobCB workerJobCB = NULL;
+static void *workerJobData     = NULL;
+static int32 workerJobCount    = 0;
+static std::atomic<int32> workerNextJob(0);
+
+static uint32 workerBatchID      = 0;
+static int32 workerFinishedCount = 0;
+static bool32 workerQuit         = false;
+
+static thread_local bool32 isWorkerThread = false;
+
+static void RunWorkerJobList()
+{
+    int32 jobID;
+    while ((jobID = workerNextJob.fetch_add(1)) < workerJobCount) workerJobCB(workerJobData, jobID);
+}
+
+static void WorkerThreadLoop()
+{
+    isWorkerThread = true;
+
+    uint32 batchID = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(workerMutex);
+            workerStartCV.wait(lock, [&] { return workerQuit || workerBatchID != batchID; });
+
+            if (workerQuit)
+                return;
+
+            batchID = workerBatchID;
+        }
+
+        RunWorkerJobList();
+
+        // the batch owner waits for every worker to check back in, so no one is still reading the job list when it gets reused
+        std::lock_guard<std::mutex> lock(workerMutex);
+        if (++workerFinishedCount == workerThreadCount)
+            workerDoneCV.notify_one();
+    }
+}
+
+void RSDK::InitWorkerThreads(int32 count)
+{
+    ReleaseWorkerThreads();
+
+    if (count > WORKERTHREAD_COUNT)
+        count = WORKERTHREAD_COUNT;
+
+    workerQuit = false;
+    for (int32 t = 0; t < count; ++t) {
+        workerThreads[t] = std::thread(WorkerThreadLoop);
+        workerThreadCount++;
+    }
+
+    if (workerThreadCount)
+        PrintLog(PRINT_NORMAL, "Started %d worker threads", workerThreadCount);
+}
+
+void RSDK::ReleaseWorkerThreads()
+{
+    if (!workerThreadCount)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        workerQuit = true;
+    }
+    workerStartCV.notify_all();
+
+    for (int32 t = 0; t < workerThreadCount; ++t) workerThreads[t].join();
+    workerThreadCount = 0;
+}
+
+void RSDK::RunWorkerJobs(WorkerJobCB callback, void *data, int32 jobCount)
+{
+    if (jobCount <= 0)
+        return;
+
+    if (!workerThreadCount || jobCount == 1 || isWorkerThread) {
+        for (int32 j = 0; j < jobCount; ++j) callback(data, j);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        workerJobCB         = callback;
+        workerJobData       = data;
+        workerJobCount      = jobCount;
+        workerFinishedCount = 0;
+        workerNextJob       = 0;
+        workerBatchID++;
+    }
+    workerStartCV.notify_all();
+
+    isWorkerThread = true;
+    RunWorkerJobList();
+    isWorkerThread = false;
+
+    std::unique_lock<std::mutex> lock(workerMutex);
+    workerDoneCV.wait(lock, [] { return workerFinishedCount == workerThreadCount; });
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef THREADING_H
+#define THREADING_H
+
+#define WORKERTHREAD_COUNT (15)
+
+// state the drawing code reads through globals that needs a copy per thread when screens are drawn in parallel
+#if RETRO_USE_THREADS
+#define RETRO_THREAD_LOCAL thread_local
+#else
+#define RETRO_THREAD_LOCAL
+#endif
+
+namespace RSDK
+{
+
+#if RETRO_USE_THREADS
+typedef void (*WorkerJobCB)(void *data, int32 jobID);
+
+extern int32 workerThreadCount;
+
+// spawns count worker threads (capped to WORKERTHREAD_COUNT), a count of 0 leaves everything on the main thread
+void InitWorkerThreads(int32 count);
+void ReleaseWorkerThreads();
+
+// runs callback(data, 0..jobCount-1) across the workers and the calling thread, returns once every job has finished
+// calling this from inside a job runs the jobs serially on that thread
+void RunWorkerJobs(WorkerJobCB callback, void *data, int32 jobCount);
+#endif
+
+} // namespace RSDK
+
+#endif
@@ -891,12 +891,8 @@ void RSDK::DevMenu_SceneSelectMenu()
 }
 void RSDK::DevMenu_OptionsMenu()
 {
-    const uint8 selectionCount = RETRO_REV02 ? 5 : 4;
-#if RETRO_REV02
-    uint32 selectionColors[] = { 0x808090, 0x808090, 0x808090, 0x808090, 0x808090 };
-#else
-    uint32 selectionColors[] = { 0x808090, 0x808090, 0x808090, 0x808090 };
-#endif
+    const uint8 selectionCount = (RETRO_REV02 ? 5 : 4) + RETRO_USE_STORAGE_TELEMETRY;
+    uint32 selectionColors[]   = { 0x808090, 0x808090, 0x808090, 0x808090, 0x808090, 0x808090 };
     selectionColors[devMenu.selection] = 0xF0F0F0;
 
     int32 dy = currentScreen->center.y;
@@ -906,7 +902,7 @@ void RSDK::DevMenu_OptionsMenu()
     DrawDevString("OPTIONS", currentScreen->center.x, dy, ALIGN_CENTER, 0xF0F0F0);
 
     dy += 44;
-    DrawRectangle(currentScreen->center.x - 128, dy - 8, 0x100, 0x48, 0x80, 0xFF, INK_NONE, true);
+    DrawRectangle(currentScreen->center.x - 128, dy - 8, 0x100, 0x48 + 12 * RETRO_USE_STORAGE_TELEMETRY, 0x80, 0xFF, INK_NONE, true);
 
     DrawDevString("Video Settings", currentScreen->center.x, dy, ALIGN_CENTER, selectionColors[0]);
 
@@ -920,6 +916,11 @@ void RSDK::DevMenu_OptionsMenu()
     dy += 12;
     DrawDevString("Debug Flags", currentScreen->center.x, dy, ALIGN_CENTER, selectionColors[3]);
 
+#endif
+#if RETRO_USE_STORAGE_TELEMETRY
+    dy += 12;
+    DrawDevString("Storage Stats", currentScreen->center.x, dy, ALIGN_CENTER, selectionColors[selectionCount - 2]);
+
 #endif
     DrawDevString("Back", currentScreen->center.x, dy + 12, ALIGN_CENTER, selectionColors[selectionCount - 1]);
 
@@ -1001,11 +1002,16 @@ void RSDK::DevMenu_OptionsMenu()
                 devMenu.scrollPos = 0;
 #endif
                 break;
+#endif
 
-            case 4:
-#else
-            case 3:
+#if RETRO_USE_STORAGE_TELEMETRY
+            case selectionCount - 2:
+                devMenu.state     = DevMenu_StorageMenu;
+                devMenu.selection = 0;
+                break;
 #endif
+
+            case selectionCount - 1:
                 devMenu.state     = DevMenu_MainMenu;
                 devMenu.selection = 0;
                 break;
@@ -1874,6 +1880,96 @@ void RSDK::DevMenu_DebugOptionsMenu()
 }
 #endif
 
+#if RETRO_USE_STORAGE_TELEMETRY
+void RSDK::DevMenu_StorageMenu()
+{
+    const char *setNames[] = { "STG", "MUS", "SFX", "STR", "TMP" };
+
+    int32 dy = currentScreen->center.y;
+    DrawRectangle(currentScreen->center.x - 128, dy - 84, 0x100, 0x30, 0x80, 0xFF, INK_NONE, true);
+
+    dy -= 68;
+    DrawDevString("STORAGE STATS", currentScreen->center.x, dy, ALIGN_CENTER, 0xF0F0F0);
+
+    dy += 8;
+    DrawDevString("(kb, since the last scene load)", currentScreen->center.x, dy, ALIGN_CENTER, 0x808090);
+
+    dy += 28;
+    DrawRectangle(currentScreen->center.x - 128, dy - 4, 0x100, 0xA4, 0x80, 0xFF, INK_NONE, true);
+    DrawDevString("SET   USED  PEAK LIMIT  ENTRIES", currentScreen->center.x - 120, dy, ALIGN_LEFT, 0xF0F080);
+
+    char buffer[0x40];
+    for (int32 s = 0; s < DATASET_MAX; ++s) {
+        DataStorage *storage        = &dataStorage[s];
+        StorageTelemetry *telemetry = &storageTelemetry[s];
+
+        dy += 8;
+        sprintf_s(buffer, sizeof(buffer), "%s %6d%6d%6d %4d/%-4d", setNames[s], storage->usedStorage / 0x100, telemetry->peakStorage / 0x100,
+                  storage->storageLimit / 0x100, storage->entryCount, telemetry->peakEntries);
+        DrawDevString(buffer, currentScreen->center.x - 120, dy, ALIGN_LEFT, s == devMenu.selection ? 0xF0F0F0 : 0x808090);
+    }
+
+    StorageTelemetry *telemetry = &storageTelemetry[devMenu.selection];
+    dy += 12;
+    sprintf_s(buffer, sizeof(buffer), "%d allocs, %d failed, %d gcs (%.1fms)", telemetry->allocCount, telemetry->failedCount, telemetry->gcCount,
+              telemetry->gcTicks * 1000.0f / CLOCKS_PER_SEC);
+    DrawDevString(buffer, currentScreen->center.x, dy, ALIGN_CENTER, 0xF0F0F0);
+
+    // size histogram, one bar per power of two from 16 bytes up
+    uint32 maxCount = 1;
+    for (int32 b = 0; b < STORAGE_HISTOGRAM_COUNT; ++b) maxCount = MAX(maxCount, telemetry->histogram[b]);
+
+    dy += 36;
+    for (int32 b = 0; b < STORAGE_HISTOGRAM_COUNT; ++b) {
+        int32 height = (int32)(telemetry->histogram[b] * 24 / maxCount);
+        if (telemetry->histogram[b] && !height)
+            height = 1;
+        DrawRectangle(currentScreen->center.x - 120 + b * 16, dy - height, 12, height, 0xF0F0F0, 0xFF, INK_NONE, true);
+    }
+    DrawDevString("16b", currentScreen->center.x - 120, dy + 2, ALIGN_LEFT, 0x808090);
+    DrawDevString(">128kb", currentScreen->center.x + 120, dy + 2, ALIGN_RIGHT, 0x808090);
+
+    int32 topSites[STORAGE_TOP_CALLSITES];
+    int32 topCount = GetTopStorageCallSites((StorageDataSets)devMenu.selection, topSites, STORAGE_TOP_CALLSITES);
+
+    dy += 6;
+    for (int32 i = 0; i < topCount; ++i) {
+        StorageCallSite *site = &storageCallSites[topSites[i]];
+
+        const char *file = site->file;
+        for (const char *c = site->file; *c; ++c) {
+            if (*c == '/' || *c == '\\')
+                file = c + 1;
+        }
+
+        dy += 8;
+        sprintf_s(buffer, sizeof(buffer), "%s:%d", file, site->line);
+        DrawDevString(buffer, currentScreen->center.x - 120, dy, ALIGN_LEFT, 0x808090);
+        sprintf_s(buffer, sizeof(buffer), "%dx %dkb", site->allocCount, site->allocBytes / 1024);
+        DrawDevString(buffer, currentScreen->center.x + 120, dy, ALIGN_RIGHT, 0x808090);
+    }
+
+#if !RETRO_USE_ORIGINAL_CODE
+    DevMenu_HandleTouchControls(CORNERBUTTON_START);
+#endif
+
+    if (controller[CONT_ANY].keyUp.press) {
+        if (--devMenu.selection < 0)
+            devMenu.selection = DATASET_MAX - 1;
+    }
+    else if (controller[CONT_ANY].keyDown.press) {
+        if (++devMenu.selection >= DATASET_MAX)
+            devMenu.selection = 0;
+    }
+
+    // nothing to confirm here, so any button goes back
+    if (controller[CONT_ANY].keyStart.press || controller[CONT_ANY].keyA.press || controller[CONT_ANY].keyB.press) {
+        devMenu.state     = DevMenu_OptionsMenu;
+        devMenu.selection = RETRO_REV02 ? 4 : 3;
+    }
+}
+#endif
+
 #if RETRO_USE_MOD_LOADER
 void RSDK::DevMenu_ModsMenu()
 {
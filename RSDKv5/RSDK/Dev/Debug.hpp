@@ -135,6 +135,9 @@ void DevMenu_KeyMappingsMenu();
 #if RETRO_REV02
 void DevMenu_DebugOptionsMenu();
 #endif
+#if RETRO_USE_STORAGE_TELEMETRY
+void DevMenu_StorageMenu();
+#endif
 #if RETRO_USE_MOD_LOADER
 void DevMenu_ModsMenu();
 #endif
@@ -143,6 +143,8 @@ const RenderVertex rsdkVertexBuffer[24] =
 #include "Vulkan/VulkanRenderDevice.cpp"
 #elif RETRO_RENDERDEVICE_EGL
 #include "EGL/EGLRenderDevice.cpp"
+#elif RETRO_RENDERDEVICE_HEADLESS
+#include "Headless/HeadlessRenderDevice.cpp"
 #endif
 
 RenderDevice::WindowInfo RenderDevice::displayInfo;
@@ -158,7 +160,7 @@ float RSDK::dpi         = 1;
 int32 RSDK::cameraCount = 0;
 ScreenInfo RSDK::screens[SCREEN_COUNT];
 CameraInfo RSDK::cameras[CAMERA_COUNT];
-ScreenInfo *RSDK::currentScreen = NULL;
+RETRO_THREAD_LOCAL ScreenInfo *RSDK::currentScreen = NULL;
 
 int32 RSDK::shaderCount = 0;
 ShaderEntry RSDK::shaderList[SHADER_COUNT];
@@ -199,56 +201,175 @@ char RSDK::drawGroupNames[0x10][0x10] = {
 // 50% alpha, but way faster
 #define setPixelBlend(pixel, frameBufferClr) frameBufferClr = ((pixel >> 1) & 0x3DEF) + ((frameBufferClr >> 1) & 0x3DEF)
 
-static inline void setPixelAlpha_func(uint16 pixel, uint16 &frameBufferClr, int32 alpha, const uint16 *fbufferBlend, const uint16 *pixelBlend) {
+static inline void setPixelAlpha(uint16 pixel, uint16 &frameBufferClr, const uint16 *fbufferBlend, const uint16 *pixelBlend)
+{
     int32 R = fbufferBlend[frameBufferClr & 0x1F] + pixelBlend[pixel & 0x1F];
     int32 G = (fbufferBlend[(frameBufferClr & 0x3E0) >> 5] + pixelBlend[(pixel & 0x3E0) >> 5]) << 5;
     int32 B = (fbufferBlend[(frameBufferClr & 0x7C00) >> 10] + pixelBlend[(pixel & 0x7C00) >> 10]) << 10;
     frameBufferClr = R | G | B;
 }
 
-static inline void setPixelAdditive_func(uint16 pixel, uint16 &frameBufferClr, const uint16 *blendTablePtr) {
+static inline void setPixelAdditive(uint16 pixel, uint16 &frameBufferClr, const uint16 *blendTablePtr)
+{
     int32 R = MIN(blendTablePtr[pixel & 0x1F] + (frameBufferClr & 0x1F), 0x1F);
     int32 G = MIN((blendTablePtr[(pixel & 0x3E0) >> 5] << 5) + (frameBufferClr & 0x3E0), 0x3E0);
     int32 B = MIN((blendTablePtr[(pixel & 0x7C00) >> 10] << 10) + (frameBufferClr & 0x7C00), 0x7C00);
     frameBufferClr = R | G | B;
 }
 
-static inline void setPixelSubtractive_func(uint16 pixel, uint16 &frameBufferClr, const uint16 *subBlendTable) {
+static inline void setPixelSubtractive(uint16 pixel, uint16 &frameBufferClr, const uint16 *subBlendTable)
+{
     int32 R = MAX((frameBufferClr & 0x1F) - subBlendTable[pixel & 0x1F], 0);
     int32 G = MAX((frameBufferClr & 0x3E0) - (subBlendTable[(pixel & 0x3E0) >> 5] << 5), 0);
     int32 B = MAX((frameBufferClr & 0x7C00) - (subBlendTable[(pixel & 0x7C00) >> 10] << 10), 0);
     frameBufferClr = R | G | B;
 }
 
-#define setPixelAlpha(pixel, frameBufferClr, alpha)                                                                                                  \
-    int32 R = fbufferBlend[frameBufferClr & 0x1F] + pixelBlend[pixel & 0x1F];                                                                        \
-    int32 G = (fbufferBlend[(frameBufferClr & 0x3E0) >> 5] + pixelBlend[(pixel & 0x3E0) >> 5]) << 5;                                                \
-    int32 B = (fbufferBlend[(frameBufferClr & 0x7C00) >> 10] + pixelBlend[(pixel & 0x7C00) >> 10]) << 10;                                           \
-    frameBufferClr = R | G | B;
+// SIMD versions of the alpha/additive/subtractive blends, 8 pixels at a time
+// each channel is ((value * alpha) >> 8), the same as blendLookupTable/subtractLookupTable, so the results match the tables exactly
+#if RETRO_USE_SSE2
+template <InkEffects inkEffect> static inline __m128i BlendChannel8(__m128i dst, __m128i src, int32 alpha)
+{
+    const __m128i channelMask = _mm_set1_epi16(0x1F);
+    __m128i srcAlpha          = _mm_set1_epi16(alpha);
 
-// Additive Blending
-#define setPixelAdditive(pixel, frameBufferClr)                                                                                                      \
-    int32 R = MIN(blendTablePtr[pixel & 0x1F] + (frameBufferClr & 0x1F), 0x1F);                                                                      \
-    int32 G = MIN((blendTablePtr[(pixel & 0x3E0) >> 5] << 5) + (frameBufferClr & 0x3E0), 0x3E0);                                                    \
-    int32 B = MIN((blendTablePtr[(pixel & 0x7C00) >> 10] << 10) + (frameBufferClr & 0x7C00), 0x7C00);                                               \
-    frameBufferClr = R | G | B;
+    switch (inkEffect) {
+        default:
+        case INK_ALPHA: {
+            __m128i dstAlpha = _mm_set1_epi16(0xFF - alpha);
+            return _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(dst, dstAlpha), 8), _mm_srli_epi16(_mm_mullo_epi16(src, srcAlpha), 8));
+        }
 
-// Subtractive Blending
-#define setPixelSubtractive(pixel, frameBufferClr)                                                                                                   \
-    int32 R = MAX((frameBufferClr & 0x1F) - subBlendTable[pixel & 0x1F], 0);                                                                         \
-    int32 G = MAX((frameBufferClr & 0x3E0) - (subBlendTable[(pixel & 0x3E0) >> 5] << 5), 0);                                                        \
-    int32 B = MAX((frameBufferClr & 0x7C00) - (subBlendTable[(pixel & 0x7C00) >> 10] << 10), 0);                                                    \
-    frameBufferClr = R | G | B;
+        case INK_ADD: return _mm_min_epi16(_mm_add_epi16(dst, _mm_srli_epi16(_mm_mullo_epi16(src, srcAlpha), 8)), channelMask);
+
+        // (0x1F - src) is the same as (src ^ 0x1F) for a 5-bit channel
+        case INK_SUB: return _mm_subs_epu16(dst, _mm_srli_epi16(_mm_mullo_epi16(_mm_xor_si128(src, channelMask), srcAlpha), 8));
+    }
+}
+#elif RETRO_USE_NEON
+template <InkEffects inkEffect> static inline uint16x8_t BlendChannel8(uint16x8_t dst, uint16x8_t src, int32 alpha)
+{
+    const uint16x8_t channelMask = vdupq_n_u16(0x1F);
+    uint16x8_t srcAlpha          = vdupq_n_u16(alpha);
+
+    switch (inkEffect) {
+        default:
+        case INK_ALPHA: {
+            uint16x8_t dstAlpha = vdupq_n_u16(0xFF - alpha);
+            return vaddq_u16(vshrq_n_u16(vmulq_u16(dst, dstAlpha), 8), vshrq_n_u16(vmulq_u16(src, srcAlpha), 8));
+        }
+
+        case INK_ADD: return vminq_u16(vaddq_u16(dst, vshrq_n_u16(vmulq_u16(src, srcAlpha), 8)), channelMask);
+
+        case INK_SUB: return vqsubq_u16(dst, vshrq_n_u16(vmulq_u16(veorq_u16(src, channelMask), srcAlpha), 8));
+    }
+}
+#endif
+
+// blends 8 src pixels onto dst, mask is 0xFFFF for every pixel that should be drawn (or NULL to draw all of them)
+// pixels are 5 bits per channel, alphaR/G/B are applied to bits 0-4/5-9/10-14. that R/B assignment follows how FillScreen (& rgb32To16_R)
+// packs its colour, which is swapped from the palette format (red in bits 10-14). every other caller passes the same alpha for all three
+template <InkEffects inkEffect>
+static inline void BlendPixels8(uint16 *dst, const uint16 *src, const uint16 *mask, int32 alphaR, int32 alphaG, int32 alphaB)
+{
+#if RETRO_USE_SSE2
+    const __m128i channelMask = _mm_set1_epi16(0x1F);
+    __m128i dstClr            = _mm_loadu_si128((const __m128i *)dst);
+    __m128i srcClr            = _mm_loadu_si128((const __m128i *)src);
+
+    __m128i R = BlendChannel8<inkEffect>(_mm_and_si128(dstClr, channelMask), _mm_and_si128(srcClr, channelMask), alphaR);
+    __m128i G = BlendChannel8<inkEffect>(_mm_and_si128(_mm_srli_epi16(dstClr, 5), channelMask),
+                                         _mm_and_si128(_mm_srli_epi16(srcClr, 5), channelMask), alphaG);
+    __m128i B = BlendChannel8<inkEffect>(_mm_and_si128(_mm_srli_epi16(dstClr, 10), channelMask),
+                                         _mm_and_si128(_mm_srli_epi16(srcClr, 10), channelMask), alphaB);
+
+    __m128i result = _mm_or_si128(R, _mm_or_si128(_mm_slli_epi16(G, 5), _mm_slli_epi16(B, 10)));
+    if (mask) {
+        __m128i drawMask = _mm_loadu_si128((const __m128i *)mask);
+        result           = _mm_or_si128(_mm_and_si128(drawMask, result), _mm_andnot_si128(drawMask, dstClr));
+    }
+    _mm_storeu_si128((__m128i *)dst, result);
+#elif RETRO_USE_NEON
+    const uint16x8_t channelMask = vdupq_n_u16(0x1F);
+    uint16x8_t dstClr            = vld1q_u16(dst);
+    uint16x8_t srcClr            = vld1q_u16(src);
+
+    uint16x8_t R = BlendChannel8<inkEffect>(vandq_u16(dstClr, channelMask), vandq_u16(srcClr, channelMask), alphaR);
+    uint16x8_t G = BlendChannel8<inkEffect>(vandq_u16(vshrq_n_u16(dstClr, 5), channelMask), vandq_u16(vshrq_n_u16(srcClr, 5), channelMask), alphaG);
+    uint16x8_t B = BlendChannel8<inkEffect>(vandq_u16(vshrq_n_u16(dstClr, 10), channelMask), vandq_u16(vshrq_n_u16(srcClr, 10), channelMask), alphaB);
+
+    uint16x8_t result = vorrq_u16(R, vorrq_u16(vshlq_n_u16(G, 5), vshlq_n_u16(B, 10)));
+    if (mask)
+        result = vbslq_u16(vld1q_u16(mask), result, dstClr);
+    vst1q_u16(dst, result);
+#else
+    const uint16 *tablesR[2] = { &blendLookupTable[0x20 * alphaR], &blendLookupTable[0x20 * (0xFF - alphaR)] };
+    const uint16 *tablesG[2] = { &blendLookupTable[0x20 * alphaG], &blendLookupTable[0x20 * (0xFF - alphaG)] };
+    const uint16 *tablesB[2] = { &blendLookupTable[0x20 * alphaB], &blendLookupTable[0x20 * (0xFF - alphaB)] };
+    if (inkEffect == INK_SUB) {
+        tablesR[0] = &subtractLookupTable[0x20 * alphaR];
+        tablesG[0] = &subtractLookupTable[0x20 * alphaG];
+        tablesB[0] = &subtractLookupTable[0x20 * alphaB];
+    }
+
+    for (int32 i = 0; i < 8; ++i) {
+        if (mask && !mask[i])
+            continue;
 
-// Only draw if framebuffer clr IS maskColor
-#define setPixelMasked(pixel, frameBufferClr)                                                                                                        \
-    if (frameBufferClr == maskColor)                                                                                                                 \
-        frameBufferClr = pixel;
+        uint16 pixel = src[i];
+        uint16 clr   = dst[i];
+        int32 R = 0, G = 0, B = 0;
+        switch (inkEffect) {
+            default:
+            case INK_ALPHA:
+                R = tablesR[1][clr & 0x1F] + tablesR[0][pixel & 0x1F];
+                G = tablesG[1][(clr >> 5) & 0x1F] + tablesG[0][(pixel >> 5) & 0x1F];
+                B = tablesB[1][(clr >> 10) & 0x1F] + tablesB[0][(pixel >> 10) & 0x1F];
+                break;
+
+            case INK_ADD:
+                R = MIN(tablesR[0][pixel & 0x1F] + (clr & 0x1F), 0x1F);
+                G = MIN(tablesG[0][(pixel >> 5) & 0x1F] + ((clr >> 5) & 0x1F), 0x1F);
+                B = MIN(tablesB[0][(pixel >> 10) & 0x1F] + ((clr >> 10) & 0x1F), 0x1F);
+                break;
+
+            case INK_SUB:
+                R = MAX((clr & 0x1F) - tablesR[0][pixel & 0x1F], 0);
+                G = MAX(((clr >> 5) & 0x1F) - tablesG[0][(pixel >> 5) & 0x1F], 0);
+                B = MAX(((clr >> 10) & 0x1F) - tablesB[0][(pixel >> 10) & 0x1F], 0);
+                break;
+        }
+        dst[i] = R | (G << 5) | (B << 10);
+    }
+#endif
+}
+
+// same as BlendPixels8, but only count (1-8) pixels of dst are written, src & mask still need 8 entries
+template <InkEffects inkEffect>
+static inline void BlendPixels(uint16 *dst, const uint16 *src, const uint16 *mask, int32 count, int32 alphaR, int32 alphaG, int32 alphaB)
+{
+    if (count == 8) {
+        BlendPixels8<inkEffect>(dst, src, mask, alphaR, alphaG, alphaB);
+    }
+    else {
+        // the unused lanes still get loaded & blended, so they're zeroed rather than left uninitialized
+        uint16 pixels[8] = { 0 };
+        memcpy(pixels, dst, count * sizeof(uint16));
+        BlendPixels8<inkEffect>(pixels, src, mask, alphaR, alphaG, alphaB);
+        memcpy(dst, pixels, count * sizeof(uint16));
+    }
+}
+
+template <InkEffects inkEffect> static void BlendFill(uint16 *dst, uint16 color, int32 count, int32 alphaR, int32 alphaG, int32 alphaB)
+{
+    uint16 colors[8];
+    for (int32 i = 0; i < 8; ++i) colors[i] = color;
+
+    for (; count >= 8; count -= 8, dst += 8) BlendPixels8<inkEffect>(dst, colors, NULL, alphaR, alphaG, alphaB);
 
-// Only draw if framebuffer clr is NOT maskColor
-#define setPixelUnmasked(pixel, frameBufferClr)                                                                                                      \
-    if (frameBufferClr != maskColor)                                                                                                                 \
-        frameBufferClr = pixel;
+    if (count > 0)
+        BlendPixels<inkEffect>(dst, colors, NULL, count, alphaR, alphaG, alphaB);
+}
 
 void RSDK::RenderDeviceBase::ProcessDimming()
 {
@@ -273,6 +394,91 @@ void RSDK::RenderDeviceBase::ProcessDimming()
     }
 }
 
+#if RETRO_VALIDATE_BLEND_KERNELS
+static inline int32 BlendChannelReference(int32 inkEffect, int32 dst, int32 src, int32 alpha)
+{
+    switch (inkEffect) {
+        default:
+        case INK_ALPHA: return blendLookupTable[0x20 * (0xFF - alpha) + dst] + blendLookupTable[0x20 * alpha + src];
+        case INK_ADD: return MIN(blendLookupTable[0x20 * alpha + src] + dst, 0x1F);
+        case INK_SUB: return MAX(dst - subtractLookupTable[0x20 * alpha + src], 0);
+    }
+}
+
+// packs a channel value into all 3 channels, each one different so a channel mixup can't go unnoticed
+static inline uint16 BlendTestPixel(int32 value) { return value | ((value ^ 0x0A) << 5) | ((0x1F - value) << 10); }
+
+template <InkEffects inkEffect> static bool32 ValidateBlendKernel(const char *name)
+{
+    uint16 src[8], dst[8], mask[8];
+    for (int32 i = 0; i < 8; ++i) mask[i] = (i & 1) ? 0x0000 : 0xFFFF;
+
+    for (int32 alpha = 0; alpha < 0x100; ++alpha) {
+        int32 alphas[3] = { alpha, (alpha + 0x55) & 0xFF, (alpha + 0xAA) & 0xFF };
+
+        // every dst/src channel pair at every alpha, with & without a mask
+        for (int32 d = 0; d < 0x20; ++d) {
+            for (int32 s = 0; s < 0x20; s += 8) {
+                for (int32 useMask = 0; useMask < 2; ++useMask) {
+                    for (int32 i = 0; i < 8; ++i) {
+                        dst[i] = BlendTestPixel(d);
+                        src[i] = BlendTestPixel(s + i);
+                    }
+
+                    BlendPixels8<inkEffect>(dst, src, useMask ? mask : NULL, alphas[0], alphas[1], alphas[2]);
+
+                    for (int32 i = 0; i < 8; ++i) {
+                        uint16 expected = BlendTestPixel(d);
+                        if (!useMask || mask[i]) {
+                            expected = 0;
+                            for (int32 c = 0; c < 3; ++c) {
+                                int32 shift = c * 5;
+                                expected |= BlendChannelReference(inkEffect, (BlendTestPixel(d) >> shift) & 0x1F, (src[i] >> shift) & 0x1F, alphas[c])
+                                            << shift;
+                            }
+                        }
+
+                        if (dst[i] != expected) {
+                            PrintLog(PRINT_ERROR, "BlendPixels8<%s> mismatch: alpha %d, dst %04X, src %04X, mask %d, expected %04X, got %04X", name, alpha,
+                                     BlendTestPixel(d), src[i], useMask, expected, dst[i]);
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+
+        // BlendFill's tails, making sure nothing past count gets written
+        uint16 color = BlendTestPixel(alpha & 0x1F);
+        for (int32 count = 1; count <= 17; ++count) {
+            uint16 pixels[24];
+            for (int32 i = 0; i < 24; ++i) pixels[i] = BlendTestPixel(i & 0x1F);
+
+            BlendFill<inkEffect>(pixels, color, count, alphas[0], alphas[1], alphas[2]);
+
+            for (int32 i = 0; i < 24; ++i) {
+                uint16 expected = BlendTestPixel(i & 0x1F);
+                if (i < count) {
+                    expected = 0;
+                    for (int32 c = 0; c < 3; ++c) {
+                        int32 shift = c * 5;
+                        expected |= BlendChannelReference(inkEffect, (BlendTestPixel(i) >> shift) & 0x1F, (color >> shift) & 0x1F, alphas[c]) << shift;
+                    }
+                }
+
+                if (pixels[i] != expected) {
+                    PrintLog(PRINT_ERROR, "BlendFill<%s> mismatch: alpha %d, count %d, pixel %d, expected %04X, got %04X", name, alpha, count, i, expected,
+                             pixels[i]);
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+#endif
+
 void RSDK::GenerateBlendLookupTable()
 {
     for (int32 y = 0; y < 0x100; y++) {
@@ -296,6 +502,11 @@ void RSDK::GenerateBlendLookupTable()
         rgb32To16_G[c] = c5 << 5;   
         rgb32To16_B[c] = c5 << 10;  
     }
+
+#if RETRO_VALIDATE_BLEND_KERNELS
+    if (ValidateBlendKernel<INK_ALPHA>("INK_ALPHA") && ValidateBlendKernel<INK_ADD>("INK_ADD") && ValidateBlendKernel<INK_SUB>("INK_SUB"))
+        PrintLog(PRINT_NORMAL, "Blend kernels match the lookup tables");
+#endif
 }
 
 void RSDK::InitSystemSurfaces()
@@ -317,6 +528,78 @@ void RSDK::InitSystemSurfaces()
 #endif
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+struct SurfaceSpan {
+    uint16 start;
+    uint16 end;
+};
+
+void RSDK::BuildSurfaceSpans(GFXSurface *surface)
+{
+    surface->spanTable     = NULL;
+    surface->spanTableSize = 0;
+
+    if (!surface->pixels || surface->width <= 0 || surface->width > 0xFFFF || surface->height <= 0)
+        return;
+
+    // count the runs first so the whole table fits in one allocation
+    int32 spanCount = 0;
+    uint8 *pixels   = surface->pixels;
+    for (int32 y = 0; y < surface->height; ++y) {
+        uint8 prev = 0;
+        for (int32 x = 0; x < surface->width; ++x) {
+            if (*pixels && !prev)
+                ++spanCount;
+            prev = *pixels++;
+        }
+    }
+
+    int32 size = (surface->height + 1) * sizeof(uint32) + spanCount * sizeof(SurfaceSpan);
+    if (GetSurfaceSpanBytes() + size > SURFACE_SPANTABLE_LIMIT)
+        return;
+
+    AllocateStorage((void **)&surface->spanTable, size, DATASET_STG, false);
+    if (!surface->spanTable)
+        return;
+
+    uint32 *rowOffsets = surface->spanTable;
+    SurfaceSpan *spans = (SurfaceSpan *)&rowOffsets[surface->height + 1];
+
+    int32 spanID = 0;
+    pixels       = surface->pixels;
+    for (int32 y = 0; y < surface->height; ++y) {
+        rowOffsets[y] = spanID;
+
+        int32 x = 0;
+        while (x < surface->width) {
+            while (x < surface->width && !pixels[x]) ++x;
+            if (x >= surface->width)
+                break;
+
+            spans[spanID].start = x;
+            while (x < surface->width && pixels[x]) ++x;
+            spans[spanID++].end = x;
+        }
+
+        pixels += surface->width;
+    }
+    rowOffsets[surface->height] = spanID;
+
+    surface->spanTableSize = size;
+}
+
+int32 RSDK::GetSurfaceSpanBytes()
+{
+    int32 size = 0;
+    for (int32 s = 0; s < SURFACE_COUNT; ++s) {
+        if (gfxSurface[s].spanTable)
+            size += gfxSurface[s].spanTableSize;
+    }
+
+    return size;
+}
+#endif
+
 void RSDK::UpdateGameWindow() { RenderDevice::RefreshWindow(); }
 
 void RSDK::GetDisplayInfo(int32 *displayID, int32 *width, int32 *height, int32 *refreshRate, char *text)
@@ -604,6 +887,174 @@ void RSDK::SwapDrawListEntries(uint8 drawGroup, uint16 slot1, uint16 slot2, uint
     }
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+// lists this size or smaller are cheaper to insertion sort than to radix sort
+#define DRAWLIST_INSERTIONSORT_MAX (0x40)
+
+static uint32 drawListSortKeys[2][ENTITY_COUNT];
+static uint16 drawListSortSlots[ENTITY_COUNT];
+#endif
+
+void RSDK::SortDrawList(DrawList *list)
+{
+#if !RETRO_USE_ORIGINAL_CODE
+    int32 count   = list->entityCount;
+    uint16 *slots = list->entries;
+
+    // entities rarely change depth, so the list is usually still in order from last frame
+    int32 first = 1;
+    while (first < count && objectEntityList[slots[first]].zdepth <= objectEntityList[slots[first - 1]].zdepth) ++first;
+
+    if (first >= count)
+        return;
+
+    if (count <= DRAWLIST_INSERTIONSORT_MAX) {
+        for (int32 i = first; i < count; ++i) {
+            uint16 slot  = slots[i];
+            int32 zdepth = objectEntityList[slot].zdepth;
+
+            int32 pos = i;
+            for (; pos > 0 && objectEntityList[slots[pos - 1]].zdepth < zdepth; --pos) slots[pos] = slots[pos - 1];
+            slots[pos] = slot;
+        }
+        return;
+    }
+
+    // LSD radix sort, flipping the sign bit makes the keys sort as unsigned & inverting them puts the highest depth first
+    uint32 *keys      = drawListSortKeys[0];
+    uint32 *tempKeys  = drawListSortKeys[1];
+    uint16 *tempSlots = drawListSortSlots;
+    for (int32 i = 0; i < count; ++i) keys[i] = ~((uint32)objectEntityList[slots[i]].zdepth ^ 0x80000000);
+
+    for (int32 shift = 0; shift < 32; shift += 8) {
+        int32 offsets[0x100];
+        memset(offsets, 0, sizeof(offsets));
+        for (int32 i = 0; i < count; ++i) offsets[(keys[i] >> shift) & 0xFF]++;
+
+        // every key has the same byte here, so this pass wouldn't move anything
+        if (offsets[(keys[0] >> shift) & 0xFF] == count)
+            continue;
+
+        int32 total = 0;
+        for (int32 b = 0; b < 0x100; ++b) {
+            int32 size = offsets[b];
+            offsets[b] = total;
+            total += size;
+        }
+
+        for (int32 i = 0; i < count; ++i) {
+            int32 pos      = offsets[(keys[i] >> shift) & 0xFF]++;
+            tempKeys[pos]  = keys[i];
+            tempSlots[pos] = slots[i];
+        }
+
+        uint32 *swapKeys = keys;
+        keys             = tempKeys;
+        tempKeys         = swapKeys;
+
+        uint16 *swapSlots = slots;
+        slots             = tempSlots;
+        tempSlots         = swapSlots;
+    }
+
+    if (slots != list->entries)
+        memcpy(list->entries, slots, count * sizeof(uint16));
+#else
+    for (int32 e = 0; e < list->entityCount; ++e) {
+        for (int32 i = list->entityCount - 1; i > e; --i) {
+            int32 slot1 = list->entries[i - 1];
+            int32 slot2 = list->entries[i];
+            if (objectEntityList[slot2].zdepth > objectEntityList[slot1].zdepth) {
+                list->entries[i - 1] = slot2;
+                list->entries[i]     = slot1;
+            }
+        }
+    }
+#endif
+}
+
+#if !RETRO_USE_ORIGINAL_CODE
+// the sort ProcessObjectDrawLists used before SortDrawList, only kept as BenchmarkDrawListSort's baseline
+static void BubbleSortDrawList(DrawList *list)
+{
+    for (int32 e = 0; e < list->entityCount; ++e) {
+        for (int32 i = list->entityCount - 1; i > e; --i) {
+            int32 slot1 = list->entries[i - 1];
+            int32 slot2 = list->entries[i];
+            if (objectEntityList[slot2].zdepth > objectEntityList[slot1].zdepth) {
+                list->entries[i - 1] = slot2;
+                list->entries[i]     = slot1;
+            }
+        }
+    }
+}
+
+void RSDK::BenchmarkDrawListSort()
+{
+    const int32 counts[]   = { 500, 1000, 2000 };
+    const int32 maxCount   = 2000;
+    const int32 iterations = 20;
+
+    // the sorts read zdepth straight from objectEntityList, so the first maxCount slots get borrowed & put back afterwards
+    DrawList *lists    = NULL;
+    int32 *savedDepths = NULL;
+    AllocateStorage((void **)&lists, 2 * sizeof(DrawList), DATASET_TMP, true);
+    AllocateStorage((void **)&savedDepths, maxCount * sizeof(int32), DATASET_TMP, false);
+    if (!lists || !savedDepths) {
+        PrintLog(PRINT_NORMAL, "Draw list sort benchmark: couldn't allocate its buffers");
+        RemoveStorageEntry((void **)&lists);
+        RemoveStorageEntry((void **)&savedDepths);
+        return;
+    }
+
+    for (int32 i = 0; i < maxCount; ++i) savedDepths[i] = objectEntityList[i].zdepth;
+
+    // random depths have plenty of ties, which is where a sort that isn't stable would show up
+    const char *orderNames[] = { "random", "sorted", "nearly sorted" };
+    for (int32 o = 0; o < 3; ++o) {
+        for (int32 c = 0; c < 3; ++c) {
+            int32 count = counts[c];
+            int32 seed  = 0x1234;
+            for (int32 i = 0; i < count; ++i) {
+                switch (o) {
+                    default:
+                    case 0: objectEntityList[i].zdepth = RandSeeded(0, 0x100, &seed); break;
+                    case 1: objectEntityList[i].zdepth = count - i; break;
+                    case 2: objectEntityList[i].zdepth = (i % 50) == 49 ? count - i + 2 : count - i; break;
+                }
+            }
+
+            int32 times[2];
+            for (int32 s = 0; s < 2; ++s) {
+                DrawList *list    = &lists[s];
+                list->entityCount = count;
+
+                int64 start = GetEngineTime();
+                for (int32 it = 0; it < iterations; ++it) {
+                    for (int32 i = 0; i < count; ++i) list->entries[i] = i;
+
+                    if (s)
+                        SortDrawList(list);
+                    else
+                        BubbleSortDrawList(list);
+                }
+                times[s] = (int32)(GetEngineTime() - start);
+            }
+
+            bool32 matches = !memcmp(lists[0].entries, lists[1].entries, count * sizeof(uint16));
+            PrintLog(PRINT_NORMAL, "Draw list sort (%s, %d entries): bubble sort %.3fms, SortDrawList %.3fms, %.1fx%s", orderNames[o], count,
+                     times[0] / 1000.0f / iterations, times[1] / 1000.0f / iterations, times[1] ? (float)times[0] / times[1] : 0.0f,
+                     matches ? "" : ", ORDER DIFFERS");
+        }
+    }
+
+    for (int32 i = 0; i < maxCount; ++i) objectEntityList[i].zdepth = savedDepths[i];
+
+    RemoveStorageEntry((void **)&lists);
+    RemoveStorageEntry((void **)&savedDepths);
+}
+#endif
+
 void RSDK::FillScreen(uint32 color, int32 alphaR, int32 alphaG, int32 alphaB)
 {
     alphaR = CLAMP(alphaR, 0x00, 0xFF);
@@ -658,11 +1109,10 @@ void RSDK::FillScreen(uint32 color, int32 alphaR, int32 alphaG, int32 alphaB)
         return;
     }
 
+   #if RETRO_PLATFORM == RETRO_PS2
     int32 alpha = (alphaR + alphaG + alphaB) / 3;
     int32 invA = 255 - alpha;
 
-   #if RETRO_PLATFORM == RETRO_PS2
-
     int32 srcR_scaled = srcR5 * alpha;
     int32 srcG_scaled = srcG5 * alpha;
     int32 srcB_scaled = srcB5 * alpha;
@@ -709,7 +1159,7 @@ void RSDK::FillScreen(uint32 color, int32 alphaR, int32 alphaG, int32 alphaB)
         *fb++ = (b << 10) | (g << 5) | r;
     }
 #else
-   
+    BlendFill<INK_ALPHA>(fb, (srcB5 << 10) | (srcG5 << 5) | srcR5, total, alphaR, alphaG, alphaB);
 #endif
 }
 
@@ -982,7 +1432,7 @@ void RSDK::DrawLine(int32 x1, int32 y1, int32 x2, int32 y2, uint32 color, int32
                 uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
 
                 while (drawX1 < drawX2 || drawY1 >= drawY2) {
-                    setPixelAlpha(color16, *frameBuffer, alpha);
+                    setPixelAlpha(color16, *frameBuffer, fbufferBlend, pixelBlend);
 
                     if (hSize > -sizeX) {
                         hSize -= max;
@@ -1002,7 +1452,7 @@ void RSDK::DrawLine(int32 x1, int32 y1, int32 x2, int32 y2, uint32 color, int32
                 uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
 
                 while (true) {
-                    setPixelAlpha(color16, *frameBuffer, alpha);
+                    setPixelAlpha(color16, *frameBuffer, fbufferBlend, pixelBlend);
 
                     if (drawX1 < drawX2 || drawY1 < drawY2) {
                         if (hSize > -sizeX) {
@@ -1028,7 +1478,7 @@ void RSDK::DrawLine(int32 x1, int32 y1, int32 x2, int32 y2, uint32 color, int32
                 uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
 
                 while (drawX1 < drawX2 || drawY1 >= drawY2) {
-                    setPixelAdditive(color16, *frameBuffer);
+                    setPixelAdditive(color16, *frameBuffer, blendTablePtr);
 
                     if (hSize > -sizeX) {
                         hSize -= max;
@@ -1047,7 +1497,7 @@ void RSDK::DrawLine(int32 x1, int32 y1, int32 x2, int32 y2, uint32 color, int32
                 uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
 
                 while (true) {
-                    setPixelAdditive(color16, *frameBuffer);
+                    setPixelAdditive(color16, *frameBuffer, blendTablePtr);
                     if (drawX1 < drawX2 || drawY1 < drawY2) {
                         if (hSize > -sizeX) {
                             hSize -= max;
@@ -1072,7 +1522,7 @@ void RSDK::DrawLine(int32 x1, int32 y1, int32 x2, int32 y2, uint32 color, int32
             if (drawY1 > drawY2) {
                 uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
                 while (drawX1 < drawX2 || drawY1 >= drawY2) {
-                    setPixelSubtractive(color16, *frameBuffer);
+                    setPixelSubtractive(color16, *frameBuffer, subBlendTable);
 
                     if (hSize > -sizeX) {
                         hSize -= max;
@@ -1090,7 +1540,7 @@ void RSDK::DrawLine(int32 x1, int32 y1, int32 x2, int32 y2, uint32 color, int32
             else {
                 uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
                 while (true) {
-                    setPixelSubtractive(color16, *frameBuffer);
+                    setPixelSubtractive(color16, *frameBuffer, subBlendTable);
 
                     if (drawX1 < drawX2 || drawY1 < drawY2) {
                         if (hSize > -sizeX) {
@@ -1365,77 +1815,24 @@ void RSDK::DrawRectangle(int32 x, int32 y, int32 width, int32 height, uint32 col
     }
 
     if (inkEffect == INK_ALPHA) {
-        const uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-        const uint16 *pixelBlend = &blendLookupTable[0x20 * alpha];
-    
         for (int32 h = 0; h < height; h++) {
-            uint16 *line = frameBuffer;
-            int32 w = width;
-    
-            while (w >= 4) {
-                setPixelAlpha_func(color16, line[0], alpha, fbufferBlend, pixelBlend);
-                setPixelAlpha_func(color16, line[1], alpha, fbufferBlend, pixelBlend);
-                setPixelAlpha_func(color16, line[2], alpha, fbufferBlend, pixelBlend);
-                setPixelAlpha_func(color16, line[3], alpha, fbufferBlend, pixelBlend);
-                line += 4;
-                w -= 4;
-            }
-            while (w--) {
-                setPixelAlpha_func(color16, *line, alpha, fbufferBlend, pixelBlend);
-                ++line;
-            }
+            BlendFill<INK_ALPHA>(frameBuffer, color16, width, alpha, alpha, alpha);
             frameBuffer += pitch;
         }
         return;
     }
 
     if (inkEffect == INK_ADD) {
-        const uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
         for (int32 h = 0; h < height; h++) {
-            uint16 *line = frameBuffer;
-            int32 w = width;
-            while (w >= 4) {
-               
-                for (int i = 0; i < 4; i++) {
-                    uint16 frameBufferClr = line[i];
-                    int32 R = MIN((blendTablePtr[(color16 & 0xF800) >> 11] << 11) + (frameBufferClr & 0xF800), 0xF800);
-                    int32 G = MIN((blendTablePtr[(color16 & 0x7E0) >> 6] << 6) + (frameBufferClr & 0x7E0), 0x7E0);
-                    int32 B = MIN(blendTablePtr[color16 & 0x1F] + (frameBufferClr & 0x1F), 0x1F);
-                    line[i] = R | G | B;
-                }
-                line += 4;
-                w -= 4;
-            }
-            while (w--) {
-                setPixelAdditive(color16, *line);
-                ++line;
-            }
+            BlendFill<INK_ADD>(frameBuffer, color16, width, alpha, alpha, alpha);
             frameBuffer += pitch;
         }
         return;
     }
 
     if (inkEffect == INK_SUB) {
-        const uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
         for (int32 h = 0; h < height; h++) {
-            uint16 *line = frameBuffer;
-            int32 w = width;
-            while (w >= 4) {
-
-                for (int i = 0; i < 4; i++) {
-                    uint16 frameBufferClr = line[i];
-                    int32 R = MAX((frameBufferClr & 0xF800) - (subBlendTable[(color16 & 0xF800) >> 11] << 11), 0);
-                    int32 G = MAX((frameBufferClr & 0x7E0) - (subBlendTable[(color16 & 0x7E0) >> 6] << 6), 0);
-                    int32 B = MAX((frameBufferClr & 0x1F) - subBlendTable[color16 & 0x1F], 0);
-                    line[i] = R | G | B;
-                }
-                line += 4;
-                w -= 4;
-            }
-            while (w--) {
-                setPixelSubtractive(color16, *line);
-                ++line;
-            }
+            BlendFill<INK_SUB>(frameBuffer, color16, width, alpha, alpha, alpha);
             frameBuffer += pitch;
         }
         return;
@@ -1698,7 +2095,7 @@ void RSDK::DrawCircle(int32 x, int32 y, int32 radius, uint32 color, int32 alpha,
 
                             int32 count = edge->end - edge->start;
                             for (int32 x = 0; x < count; ++x) {
-                                setPixelAlpha(color16, frameBuffer[edge->start + x], alpha);
+                                setPixelAlpha(color16, frameBuffer[edge->start + x], fbufferBlend, pixelBlend);
                             }
                             ++edge;
                             frameBuffer += currentScreen->pitch;
@@ -1725,7 +2122,7 @@ void RSDK::DrawCircle(int32 x, int32 y, int32 radius, uint32 color, int32 alpha,
 
                             int32 count = edge->end - edge->start;
                             for (int32 x = 0; x < count; ++x) {
-                                setPixelAdditive(color16, frameBuffer[edge->start + x]);
+                                setPixelAdditive(color16, frameBuffer[edge->start + x], blendTablePtr);
                             }
                             ++edge;
                             frameBuffer += currentScreen->pitch;
@@ -1753,7 +2150,7 @@ void RSDK::DrawCircle(int32 x, int32 y, int32 radius, uint32 color, int32 alpha,
 
                             int32 count = edge->end - edge->start;
                             for (int32 x = 0; x < count; ++x) {
-                                setPixelSubtractive(color16, frameBuffer[edge->start + x]);
+                                setPixelSubtractive(color16, frameBuffer[edge->start + x], subBlendTable);
                             }
                             ++edge;
                             frameBuffer += currentScreen->pitch;
@@ -1978,7 +2375,7 @@ void RSDK::DrawCircleOutline(int32 x, int32 y, int32 innerRadius, int32 outerRad
                                 do {
                                     int32 r2 = y2 + distX1 * distX1;
                                     if (r2 >= ir2 && r2 < or2) {
-                                        setPixelAlpha(color16, *frameBuffer, alpha);
+                                        setPixelAlpha(color16, *frameBuffer, fbufferBlend, pixelBlend);
                                     }
                                     ++frameBuffer;
                                     ++distX1;
@@ -2005,7 +2402,7 @@ void RSDK::DrawCircleOutline(int32 x, int32 y, int32 innerRadius, int32 outerRad
                                 do {
                                     int32 r2 = y2 + distX1 * distX1;
                                     if (r2 >= ir2 && r2 < or2) {
-                                        setPixelAdditive(color16, *frameBuffer);
+                                        setPixelAdditive(color16, *frameBuffer, blendTablePtr);
                                     }
                                     ++frameBuffer;
                                     ++distX1;
@@ -2033,7 +2430,7 @@ void RSDK::DrawCircleOutline(int32 x, int32 y, int32 innerRadius, int32 outerRad
                                 do {
                                     int32 r2 = y2 + distX1 * distX1;
                                     if (r2 >= ir2 && r2 < or2) {
-                                        setPixelSubtractive(color16, *frameBuffer);
+                                        setPixelSubtractive(color16, *frameBuffer, subBlendTable);
                                     }
                                     ++frameBuffer;
                                     ++distX1;
@@ -2237,9 +2634,6 @@ void RSDK::DrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32
                 break;
 
             case INK_ALPHA: {
-                uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
                 for (int32 s = topScreen; s <= bottomScreen; ++s) {
                     if (edge->start < currentScreen->clipBound_X1)
                         edge->start = currentScreen->clipBound_X1;
@@ -2252,9 +2646,7 @@ void RSDK::DrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32
                         edge->end = currentScreen->clipBound_X2;
 
                     int32 count = edge->end - edge->start;
-                    for (int32 x = 0; x < count; ++x) {
-                        setPixelAlpha(color16, frameBuffer[edge->start + x], alpha);
-                    }
+                    BlendFill<INK_ALPHA>(&frameBuffer[edge->start], color16, count, alpha, alpha, alpha);
                     ++edge;
                     frameBuffer += currentScreen->pitch;
                 }
@@ -2262,8 +2654,6 @@ void RSDK::DrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32
             }
 
             case INK_ADD: {
-                uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-
                 for (int32 s = topScreen; s <= bottomScreen; ++s) {
                     if (edge->start < currentScreen->clipBound_X1)
                         edge->start = currentScreen->clipBound_X1;
@@ -2276,9 +2666,7 @@ void RSDK::DrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32
                         edge->end = currentScreen->clipBound_X2;
 
                     int32 count = edge->end - edge->start;
-                    for (int32 x = 0; x < count; ++x) {
-                        setPixelAdditive(color16, frameBuffer[edge->start + x]);
-                    }
+                    BlendFill<INK_ADD>(&frameBuffer[edge->start], color16, count, alpha, alpha, alpha);
 
                     ++edge;
                     frameBuffer += currentScreen->pitch;
@@ -2287,7 +2675,6 @@ void RSDK::DrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32
             }
 
             case INK_SUB: {
-                uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
                 for (int32 s = topScreen; s <= bottomScreen; ++s) {
                     if (edge->start < currentScreen->clipBound_X1)
                         edge->start = currentScreen->clipBound_X1;
@@ -2300,9 +2687,7 @@ void RSDK::DrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32
                         edge->end = currentScreen->clipBound_X2;
 
                     int32 count = edge->end - edge->start;
-                    for (int32 x = 0; x < count; ++x) {
-                        setPixelSubtractive(color16, frameBuffer[edge->start + x]);
-                    }
+                    BlendFill<INK_SUB>(&frameBuffer[edge->start], color16, count, alpha, alpha, alpha);
 
                     ++edge;
                     frameBuffer += currentScreen->pitch;
@@ -2587,7 +2972,7 @@ void RSDK::DrawBlendedFace(Vector2 *vertices, uint32 *colors, int32 vertCount, i
 
                     for (int32 x = 0; x < count; ++x) {
                         uint16 color = (startB >> 19) | ((startG >> 14) << 5) | ((startR >> 14) << 10);
-                        setPixelAlpha(color, frameBuffer[edge->start + x], alpha);
+                        setPixelAlpha(color, frameBuffer[edge->start + x], fbufferBlend, pixelBlend);
 
                         startR += deltaR;
                         startG += deltaG;
@@ -2640,7 +3025,7 @@ void RSDK::DrawBlendedFace(Vector2 *vertices, uint32 *colors, int32 vertCount, i
 
                     for (int32 x = 0; x < count; ++x) {
                         uint16 color = (startB >> 19) | ((startG >> 14) << 5) | ((startR >> 14) << 10);
-                        setPixelAdditive(color, frameBuffer[edge->start + x]);
+                        setPixelAdditive(color, frameBuffer[edge->start + x], blendTablePtr);
 
                         startR += deltaR;
                         startG += deltaG;
@@ -2694,7 +3079,7 @@ void RSDK::DrawBlendedFace(Vector2 *vertices, uint32 *colors, int32 vertCount, i
 
                     for (int32 x = 0; x < count; ++x) {
                         uint16 color = (startB >> 19) | ((startG >> 14) << 5) | ((startR >> 14) << 10);
-                        setPixelSubtractive(color, frameBuffer[edge->start + x]);
+                        setPixelSubtractive(color, frameBuffer[edge->start + x], subBlendTable);
 
                         startR += deltaR;
                         startG += deltaG;
@@ -3054,666 +3439,608 @@ void RSDK::DrawSprite(Animator *animator, Vector2 *position, bool32 screenRelati
         }
     }
 }
-void RSDK::DrawSpriteFlipped(int32 x, int32 y, int32 width, int32 height, int32 sprX, int32 sprY, int32 direction, int32 inkEffect, int32 alpha,
-                             int32 sheetID)
+struct SpriteBlitInfo {
+    uint16 *frameBuffer;
+    uint8 *pixels;
+    uint8 *lineBuffer;
+    int32 width;
+    int32 height;
+    int32 pitch;
+    int32 gfxPitch;
+    int32 alpha;
+    const uint16 *blendTable;
+    const uint16 *fbufferBlend;
+};
+
+struct SpriteRotozoomBlitInfo {
+    uint16 *frameBuffer;
+    uint8 *pixels;
+    uint8 *lineBuffer;
+    int32 width;
+    int32 height;
+    int32 pitch;
+    int32 lineSize;
+    int32 drawX;
+    int32 drawY;
+    int32 deltaX;
+    int32 deltaY;
+    int32 deltaXLen;
+    int32 deltaYLen;
+    int32 fullSprX;
+    int32 fullSprY;
+    int32 fullX;
+    int32 fullY;
+    const uint16 *blendTable;
+    const uint16 *fbufferBlend;
+};
+
+struct SpriteDeformBlitInfo {
+    uint16 *frameBuffer;
+    uint8 *pixels;
+    uint8 *lineBuffer;
+    ScanlineInfo *scanline;
+    int32 lineCount;
+    int32 pitch;
+    int32 width;
+    int32 height;
+    int32 lineSize;
+    const uint16 *blendTable;
+    const uint16 *fbufferBlend;
+};
+
+// alpha uses both tables, add & sub only use blendTable
+static inline void SetupSpriteInkTables(int32 inkEffect, int32 alpha, const uint16 **blendTable, const uint16 **fbufferBlend)
 {
+    *blendTable   = NULL;
+    *fbufferBlend = NULL;
+
     switch (inkEffect) {
         default: break;
+
         case INK_ALPHA:
-            if (alpha > 0xFF)
-                inkEffect = INK_NONE;
-            else if (alpha <= 0)
-                return;
+            *blendTable   = &blendLookupTable[0x20 * alpha];
+            *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
             break;
 
-        case INK_ADD:
-        case INK_SUB:
-            if (alpha > 0xFF)
-                alpha = 0xFF;
-            else if (alpha <= 0)
-                return;
-            break;
+        case INK_ADD: *blendTable = &blendLookupTable[0x20 * alpha]; break;
 
-        case INK_TINT:
-            if (!tintLookupTable)
-                return;
-            break;
+        case INK_SUB: *blendTable = &subtractLookupTable[0x20 * alpha]; break;
     }
-    int32 widthFlip  = width;
-    int32 heightFlip = height;
+}
 
-    if (width + x > currentScreen->clipBound_X2)
-        width = currentScreen->clipBound_X2 - x;
+// inkEffect is a template arg, so every blitter only keeps the one case it needs
+template <InkEffects inkEffect>
+static inline void SetSpritePixel(uint16 color, uint16 &frameBufferClr, const uint16 *blendTable, const uint16 *fbufferBlend)
+{
+    switch (inkEffect) {
+        default:
+        case INK_NONE: frameBufferClr = color; break;
 
-    if (x < currentScreen->clipBound_X1) {
-        int32 val = x - currentScreen->clipBound_X1;
-        sprX -= val;
-        width += val;
-        widthFlip += 2 * val;
-        x = currentScreen->clipBound_X1;
-    }
+        case INK_BLEND: setPixelBlend(color, frameBufferClr); break;
 
-    if (height + y > currentScreen->clipBound_Y2)
-        height = currentScreen->clipBound_Y2 - y;
+        case INK_ALPHA: setPixelAlpha(color, frameBufferClr, fbufferBlend, blendTable); break;
 
-    if (y < currentScreen->clipBound_Y1) {
-        int32 val = y - currentScreen->clipBound_Y1;
-        sprY -= val;
-        height += val;
-        heightFlip += 2 * val;
-        y = currentScreen->clipBound_Y1;
+        case INK_ADD: setPixelAdditive(color, frameBufferClr, blendTable); break;
+
+        case INK_SUB: setPixelSubtractive(color, frameBufferClr, blendTable); break;
+
+        case INK_TINT: frameBufferClr = tintLookupTable[frameBufferClr]; break;
+
+        case INK_MASKED:
+            if (frameBufferClr == maskColor)
+                frameBufferClr = color;
+            break;
+
+        case INK_UNMASKED:
+            if (frameBufferClr != maskColor)
+                frameBufferClr = color;
+            break;
     }
+}
 
-    if (width <= 0 || height <= 0)
+template <InkEffects inkEffect, FlipFlags direction> static void BlitSpriteFlipped(const SpriteBlitInfo *info)
+{
+    const int32 pixelStep = (direction & FLIP_X) ? -1 : 1;
+    const int32 lineStep  = (direction & FLIP_Y) ? -info->gfxPitch : info->gfxPitch;
+
+    uint16 *frameBuffer        = info->frameBuffer;
+    uint8 *pixels              = info->pixels;
+    uint8 *lineBuffer          = info->lineBuffer;
+    const uint16 *blendTable   = info->blendTable;
+    const uint16 *fbufferBlend = info->fbufferBlend;
+    int32 pitch                = info->pitch;
+    int32 height               = info->height;
+
+#if RETRO_USE_SSE2 || RETRO_USE_NEON
+    if (inkEffect == INK_ALPHA || inkEffect == INK_ADD || inkEffect == INK_SUB) {
+        int32 alpha = info->alpha;
+        while (height--) {
+            uint16 *activePalette = fullPalette[*lineBuffer++];
+            for (int32 w = info->width; w > 0; w -= 8) {
+                int32 count = MIN(w, 8);
+
+                uint16 colors[8];
+                uint16 mask[8];
+                uint8 visible = 0;
+                for (int32 i = 0; i < count; ++i) {
+                    uint8 index = *pixels;
+                    colors[i]   = activePalette[index];
+                    mask[i]     = index ? 0xFFFF : 0x0000;
+                    visible |= index;
+                    pixels += pixelStep;
+                }
+                for (int32 i = count; i < 8; ++i) {
+                    colors[i] = 0;
+                    mask[i]   = 0;
+                }
+
+                if (visible)
+                    BlendPixels<inkEffect>(frameBuffer, colors, mask, count, alpha, alpha, alpha);
+                frameBuffer += count;
+            }
+            frameBuffer += pitch;
+            pixels += lineStep;
+        }
         return;
+    }
+#endif
 
-    GFXSurface *surface = &gfxSurface[sheetID];
-    validDraw           = true;
-    int32 pitch         = currentScreen->pitch - width;
-    int32 gfxPitch      = 0;
-    uint8 *lineBuffer   = NULL;
-    uint8 *pixels       = NULL;
-    uint16 *frameBuffer = NULL;
+    while (height--) {
+        uint16 *activePalette = fullPalette[*lineBuffer++];
+        int32 w               = info->width;
+        while (w--) {
+            if (*pixels > 0)
+                SetSpritePixel<inkEffect>(activePalette[*pixels], *frameBuffer, blendTable, fbufferBlend);
+            pixels += pixelStep;
+            ++frameBuffer;
+        }
+        frameBuffer += pitch;
+        pixels += lineStep;
+    }
+}
 
-    switch (direction) {
-        default: break;
+template <InkEffects inkEffect> static void BlitSpriteRotozoom(const SpriteRotozoomBlitInfo *info)
+{
+    uint16 *frameBuffer        = info->frameBuffer;
+    uint8 *pixels              = info->pixels;
+    uint8 *lineBuffer          = info->lineBuffer;
+    const uint16 *blendTable   = info->blendTable;
+    const uint16 *fbufferBlend = info->fbufferBlend;
+    int32 lineSize             = info->lineSize;
+    int32 drawX                = info->drawX;
+    int32 drawY                = info->drawY;
+    int32 deltaX               = info->deltaX;
+    int32 deltaY               = info->deltaY;
+    int32 fullSprX             = info->fullSprX;
+    int32 fullSprY             = info->fullSprY;
+    int32 fullX                = info->fullX;
+    int32 fullY                = info->fullY;
+    for (int32 y = 0; y < info->height; ++y) {
+        uint16 *activePalette = fullPalette[*lineBuffer++];
+        int32 drawXPos        = drawX;
+        int32 drawYPos        = drawY;
+        for (int32 x = 0; x < info->width; ++x) {
+            if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
+                uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
+                if (index)
+                    SetSpritePixel<inkEffect>(activePalette[index], *frameBuffer, blendTable, fbufferBlend);
+            }
 
-        case FLIP_NONE:
-            gfxPitch    = surface->width - width;
-            lineBuffer  = &gfxLineBuffer[y];
-            pixels      = &surface->pixels[sprX + surface->width * sprY];
-            frameBuffer = &currentScreen->frameBuffer[x + currentScreen->pitch * y];
-            switch (inkEffect) {
-                case INK_NONE:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = activePalette[*pixels];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
+            ++frameBuffer;
+            drawXPos += deltaX;
+            drawYPos += deltaY;
+        }
 
-                case INK_BLEND:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                setPixelBlend(activePalette[*pixels], *frameBuffer);
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
+        drawX -= info->deltaXLen;
+        drawY += info->deltaYLen;
+        frameBuffer += info->pitch;
+    }
+}
 
-                case INK_ALPHA: {
-                    uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                    uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAlpha(color, *frameBuffer, alpha);
-                            }
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-                }
+template <InkEffects inkEffect> static void BlitSpriteDeformed(const SpriteDeformBlitInfo *info)
+{
+    uint16 *frameBuffer        = info->frameBuffer;
+    uint8 *pixels              = info->pixels;
+    uint8 *lineBuffer          = info->lineBuffer;
+    ScanlineInfo *scanline     = info->scanline;
+    const uint16 *blendTable   = info->blendTable;
+    const uint16 *fbufferBlend = info->fbufferBlend;
+    int32 pitch                = info->pitch;
+    int32 width                = info->width;
+    int32 height               = info->height;
+    int32 lineSize             = info->lineSize;
+    for (int32 l = 0; l < info->lineCount; ++l) {
+        uint16 *activePalette = fullPalette[*lineBuffer++];
+        int32 lx              = scanline->position.x;
+        int32 ly              = scanline->position.y;
+        int32 dx              = scanline->deform.x;
+        int32 dy              = scanline->deform.y;
+        for (int32 i = 0; i < pitch; ++i) {
+            uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
+            if (palIndex)
+                SetSpritePixel<inkEffect>(activePalette[palIndex], *frameBuffer, blendTable, fbufferBlend);
+
+            lx += dx;
+            ly += dy;
+            ++frameBuffer;
+        }
+        ++scanline;
+    }
+}
 
-                case INK_ADD: {
-                    uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAdditive(color, *frameBuffer);
-                            }
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-                }
+#if !RETRO_USE_ORIGINAL_CODE
+struct SpriteSpanBlitInfo {
+    uint16 *frameBuffer;
+    uint8 *lineBuffer;
+    GFXSurface *surface;
+    int32 height;
+    int32 pitch;
+    int32 row;
+    int32 colStart;
+    int32 colEnd;
+    int32 alpha;
+    const uint16 *blendTable;
+    const uint16 *fbufferBlend;
+};
 
-                case INK_SUB: {
-                    uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelSubtractive(color, *frameBuffer);
-                            }
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-                }
+// draws count opaque pixels, no transparency checks needed
+template <InkEffects inkEffect>
+static inline void BlitSpriteRun(uint16 *frameBuffer, const uint8 *pixels, int32 pixelStep, int32 count, const uint16 *activePalette,
+                                 const SpriteSpanBlitInfo *info)
+{
+    switch (inkEffect) {
+        case INK_NONE:
+            for (int32 i = 0; i < count; ++i) {
+                frameBuffer[i] = activePalette[*pixels];
+                pixels += pixelStep;
+            }
+            break;
 
-                case INK_TINT:
-                    while (height--) {
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = tintLookupTable[*frameBuffer];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
+#if RETRO_USE_SSE2 || RETRO_USE_NEON
+        case INK_ALPHA:
+        case INK_ADD:
+        case INK_SUB:
+            for (; count > 0; count -= 8) {
+                int32 chunk = MIN(count, 8);
 
-                case INK_MASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer == maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
+                uint16 colors[8];
+                for (int32 i = 0; i < chunk; ++i) {
+                    colors[i] = activePalette[*pixels];
+                    pixels += pixelStep;
+                }
+                for (int32 i = chunk; i < 8; ++i) colors[i] = 0;
 
-                case INK_UNMASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer != maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
+                BlendPixels<inkEffect>(frameBuffer, colors, NULL, chunk, info->alpha, info->alpha, info->alpha);
+                frameBuffer += chunk;
             }
             break;
+#endif
 
-        case FLIP_X:
-            gfxPitch    = width + surface->width;
-            lineBuffer  = &gfxLineBuffer[y];
-            pixels      = &surface->pixels[widthFlip - 1 + sprX + surface->width * sprY];
-            frameBuffer = &currentScreen->frameBuffer[x + currentScreen->pitch * y];
-            switch (inkEffect) {
-                case INK_NONE:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = activePalette[*pixels];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
+        default:
+            for (int32 i = 0; i < count; ++i) {
+                SetSpritePixel<inkEffect>(activePalette[*pixels], frameBuffer[i], info->blendTable, info->fbufferBlend);
+                pixels += pixelStep;
+            }
+            break;
+    }
+}
 
-                case INK_BLEND:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                setPixelBlend(activePalette[*pixels], *frameBuffer);
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
+// same output as BlitSpriteFlipped, but only visits the opaque runs of each sheet row
+template <InkEffects inkEffect, FlipFlags direction> static void BlitSpriteSpans(const SpriteSpanBlitInfo *info)
+{
+    GFXSurface *surface      = info->surface;
+    const uint32 *rowOffsets = surface->spanTable;
+    const SurfaceSpan *spans = (const SurfaceSpan *)&rowOffsets[surface->height + 1];
+    const int32 rowStep      = (direction & FLIP_Y) ? -1 : 1;
+
+    uint16 *frameBuffer = info->frameBuffer;
+    uint8 *lineBuffer   = info->lineBuffer;
+    int32 row           = info->row;
+    int32 colStart      = info->colStart;
+    int32 colEnd        = info->colEnd;
+    for (int32 h = 0; h < info->height; ++h) {
+        uint16 *activePalette = fullPalette[*lineBuffer++];
+        uint8 *pixels         = &surface->pixels[row * surface->width];
+
+        // binary search for the first run that ends past colStart
+        int32 first = rowOffsets[row];
+        int32 last  = rowOffsets[row + 1];
+        while (first < last) {
+            int32 mid = (first + last) >> 1;
+            if (spans[mid].end <= colStart)
+                first = mid + 1;
+            else
+                last = mid;
+        }
 
-                case INK_ALPHA: {
-                    uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                    uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAlpha(color, *frameBuffer, alpha);
-                            }
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-                }
+        for (int32 s = first; s < (int32)rowOffsets[row + 1] && spans[s].start < colEnd; ++s) {
+            int32 start = MAX((int32)spans[s].start, colStart);
+            int32 end   = MIN((int32)spans[s].end, colEnd);
 
-                case INK_ADD: {
-                    uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAdditive(color, *frameBuffer);
-                            }
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-                }
+            if (direction & FLIP_X)
+                BlitSpriteRun<inkEffect>(&frameBuffer[colEnd - end], &pixels[end - 1], -1, end - start, activePalette, info);
+            else
+                BlitSpriteRun<inkEffect>(&frameBuffer[start - colStart], &pixels[start], 1, end - start, activePalette, info);
+        }
 
-                case INK_SUB: {
-                    uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelSubtractive(color, *frameBuffer);
-                            }
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-                }
+        frameBuffer += info->pitch;
+        row += rowStep;
+    }
+}
+#endif
 
-                case INK_TINT:
-                    while (height--) {
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = tintLookupTable[*frameBuffer];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
+#define SPRITE_BLITTER_FLIPPED(ink)                                                                                                                  \
+    {                                                                                                                                                \
+        BlitSpriteFlipped<ink, FLIP_NONE>, BlitSpriteFlipped<ink, FLIP_X>, BlitSpriteFlipped<ink, FLIP_Y>, BlitSpriteFlipped<ink, FLIP_XY>           \
+    }
 
-                case INK_MASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer == maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
+// indexed by [inkEffect][direction]
+static void (*const spriteFlippedBlitters[INK_UNMASKED + 1][FLIP_XY + 1])(const SpriteBlitInfo *info) = {
+    SPRITE_BLITTER_FLIPPED(INK_NONE), SPRITE_BLITTER_FLIPPED(INK_BLEND), SPRITE_BLITTER_FLIPPED(INK_ALPHA),  SPRITE_BLITTER_FLIPPED(INK_ADD),
+    SPRITE_BLITTER_FLIPPED(INK_SUB),  SPRITE_BLITTER_FLIPPED(INK_TINT),  SPRITE_BLITTER_FLIPPED(INK_MASKED), SPRITE_BLITTER_FLIPPED(INK_UNMASKED),
+};
 
-                case INK_UNMASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer != maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels += gfxPitch;
-                    }
-                    break;
-            }
-            break;
+#if !RETRO_USE_ORIGINAL_CODE
+#define SPRITE_BLITTER_SPANS(ink)                                                                                                                    \
+    {                                                                                                                                                \
+        BlitSpriteSpans<ink, FLIP_NONE>, BlitSpriteSpans<ink, FLIP_X>, BlitSpriteSpans<ink, FLIP_Y>, BlitSpriteSpans<ink, FLIP_XY>                   \
+    }
 
-        case FLIP_Y:
-            gfxPitch    = width + surface->width;
-            lineBuffer  = &gfxLineBuffer[y];
-            pixels      = &surface->pixels[sprX + surface->width * (sprY + heightFlip - 1)];
-            frameBuffer = &currentScreen->frameBuffer[x + currentScreen->pitch * y];
-            switch (inkEffect) {
-                case INK_NONE:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = activePalette[*pixels];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+// indexed by [inkEffect][direction]
+static void (*const spriteSpanBlitters[INK_UNMASKED + 1][FLIP_XY + 1])(const SpriteSpanBlitInfo *info) = {
+    SPRITE_BLITTER_SPANS(INK_NONE), SPRITE_BLITTER_SPANS(INK_BLEND), SPRITE_BLITTER_SPANS(INK_ALPHA),  SPRITE_BLITTER_SPANS(INK_ADD),
+    SPRITE_BLITTER_SPANS(INK_SUB),  SPRITE_BLITTER_SPANS(INK_TINT),  SPRITE_BLITTER_SPANS(INK_MASKED), SPRITE_BLITTER_SPANS(INK_UNMASKED),
+};
+#endif
 
-                case INK_BLEND:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                setPixelBlend(activePalette[*pixels], *frameBuffer);
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+// indexed by [inkEffect]
+static void (*const spriteRotozoomBlitters[INK_UNMASKED + 1])(const SpriteRotozoomBlitInfo *info) = {
+    BlitSpriteRotozoom<INK_NONE>, BlitSpriteRotozoom<INK_BLEND>, BlitSpriteRotozoom<INK_ALPHA>,  BlitSpriteRotozoom<INK_ADD>,
+    BlitSpriteRotozoom<INK_SUB>,  BlitSpriteRotozoom<INK_TINT>,  BlitSpriteRotozoom<INK_MASKED>, BlitSpriteRotozoom<INK_UNMASKED>,
+};
 
-                case INK_ALPHA: {
-                    uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                    uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAlpha(color, *frameBuffer, alpha);
-                            }
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-                }
+// indexed by [inkEffect]
+static void (*const spriteDeformBlitters[INK_UNMASKED + 1])(const SpriteDeformBlitInfo *info) = {
+    BlitSpriteDeformed<INK_NONE>, BlitSpriteDeformed<INK_BLEND>, BlitSpriteDeformed<INK_ALPHA>,  BlitSpriteDeformed<INK_ADD>,
+    BlitSpriteDeformed<INK_SUB>,  BlitSpriteDeformed<INK_TINT>,  BlitSpriteDeformed<INK_MASKED>, BlitSpriteDeformed<INK_UNMASKED>,
+};
 
-                case INK_ADD: {
-                    uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAdditive(color, *frameBuffer);
-                            }
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+#if !RETRO_USE_ORIGINAL_CODE
+// one loop for every ink & flip that decides both per pixel, only kept as BenchmarkSpriteBlitters' baseline
+static void BlitSpriteGeneric(const SpriteBlitInfo *info, int32 inkEffect, int32 direction)
+{
+    const int32 pixelStep = (direction & FLIP_X) ? -1 : 1;
+    const int32 lineStep  = (direction & FLIP_Y) ? -info->gfxPitch : info->gfxPitch;
+
+    uint16 *frameBuffer = info->frameBuffer;
+    uint8 *pixels       = info->pixels;
+    uint8 *lineBuffer   = info->lineBuffer;
+    int32 height        = info->height;
+    while (height--) {
+        uint16 *activePalette = fullPalette[*lineBuffer++];
+        int32 w               = info->width;
+        while (w--) {
+            if (*pixels > 0) {
+                uint16 color = activePalette[*pixels];
+                switch (inkEffect) {
+                    default:
+                    case INK_NONE: SetSpritePixel<INK_NONE>(color, *frameBuffer, info->blendTable, info->fbufferBlend); break;
+                    case INK_BLEND: SetSpritePixel<INK_BLEND>(color, *frameBuffer, info->blendTable, info->fbufferBlend); break;
+                    case INK_ALPHA: SetSpritePixel<INK_ALPHA>(color, *frameBuffer, info->blendTable, info->fbufferBlend); break;
+                    case INK_ADD: SetSpritePixel<INK_ADD>(color, *frameBuffer, info->blendTable, info->fbufferBlend); break;
+                    case INK_SUB: SetSpritePixel<INK_SUB>(color, *frameBuffer, info->blendTable, info->fbufferBlend); break;
+                    case INK_TINT: SetSpritePixel<INK_TINT>(color, *frameBuffer, info->blendTable, info->fbufferBlend); break;
+                    case INK_MASKED: SetSpritePixel<INK_MASKED>(color, *frameBuffer, info->blendTable, info->fbufferBlend); break;
+                    case INK_UNMASKED: SetSpritePixel<INK_UNMASKED>(color, *frameBuffer, info->blendTable, info->fbufferBlend); break;
                 }
+            }
+            pixels += pixelStep;
+            ++frameBuffer;
+        }
+        frameBuffer += info->pitch;
+        pixels += lineStep;
+    }
+}
 
-                case INK_SUB: {
-                    uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelSubtractive(color, *frameBuffer);
-                            }
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-                }
+void RSDK::BenchmarkSpriteBlitters()
+{
+    // 32x32 sprites from a 64x64 sheet onto a 424x240 screen, cycling through every flip
+    const int32 screenWidth = 424;
+    const int32 sheetWidth  = 64;
+    const int32 spriteSize  = 32;
+    const int32 spriteCount = 10000;
+
+    uint16 *frameBuffers[2] = { NULL, NULL };
+    uint8 *sheet            = NULL;
+    uint8 *lineBuffer       = NULL;
+    AllocateStorage((void **)&frameBuffers[0], screenWidth * SCREEN_YSIZE * sizeof(uint16), DATASET_TMP, false);
+    AllocateStorage((void **)&frameBuffers[1], screenWidth * SCREEN_YSIZE * sizeof(uint16), DATASET_TMP, false);
+    AllocateStorage((void **)&sheet, sheetWidth * sheetWidth, DATASET_TMP, false);
+    AllocateStorage((void **)&lineBuffer, SCREEN_YSIZE, DATASET_TMP, true);
+    if (!frameBuffers[0] || !frameBuffers[1] || !sheet || !lineBuffer) {
+        PrintLog(PRINT_NORMAL, "Sprite blitter benchmark: couldn't allocate its buffers");
+        RemoveStorageEntry((void **)&frameBuffers[0]);
+        RemoveStorageEntry((void **)&frameBuffers[1]);
+        RemoveStorageEntry((void **)&sheet);
+        RemoveStorageEntry((void **)&lineBuffer);
+        return;
+    }
 
-                case INK_TINT:
-                    while (height--) {
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = tintLookupTable[*frameBuffer];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+    // roughly a quarter of a sprite sheet is usually transparent
+    int32 seed = 0x1234;
+    for (int32 p = 0; p < sheetWidth * sheetWidth; ++p) sheet[p] = RandSeeded(0, 4, &seed) ? RandSeeded(1, 0x100, &seed) : 0;
+
+    const char *inkNames[] = { "none", "blend", "alpha", "add", "sub", "tint", "masked", "unmasked" };
+    for (int32 ink = INK_NONE; ink <= INK_UNMASKED; ++ink) {
+        if (ink == INK_TINT && !tintLookupTable)
+            continue;
+
+        int32 times[2];
+        for (int32 b = 0; b < 2; ++b) {
+            for (int32 p = 0; p < screenWidth * SCREEN_YSIZE; ++p) frameBuffers[b][p] = p & 0x7FFF;
+
+            int64 start = GetEngineTime();
+            for (int32 s = 0; s < spriteCount; ++s) {
+                int32 x         = (s * 37) % (screenWidth - spriteSize);
+                int32 y         = (s * 53) % (SCREEN_YSIZE - spriteSize);
+                int32 sprX      = (s & 0x10) ? spriteSize : 0;
+                int32 sprY      = (s & 0x20) ? spriteSize : 0;
+                int32 direction = s & FLIP_XY;
+
+                SpriteBlitInfo info;
+                info.width       = spriteSize;
+                info.height      = spriteSize;
+                info.pitch       = screenWidth - spriteSize;
+                info.lineBuffer  = &lineBuffer[y];
+                info.frameBuffer = &frameBuffers[b][x + screenWidth * y];
+                info.alpha       = 0x80;
+                SetupSpriteInkTables(ink, info.alpha, &info.blendTable, &info.fbufferBlend);
+
+                // same setup as DrawSpriteFlipped for an unclipped sprite
+                int32 startX  = sprX + ((direction & FLIP_X) ? spriteSize - 1 : 0);
+                int32 startY  = sprY + ((direction & FLIP_Y) ? spriteSize - 1 : 0);
+                info.gfxPitch = (direction == FLIP_X || direction == FLIP_Y) ? spriteSize + sheetWidth : sheetWidth - spriteSize;
+                info.pixels   = &sheet[startX + sheetWidth * startY];
+
+                if (b)
+                    spriteFlippedBlitters[ink][direction](&info);
+                else
+                    BlitSpriteGeneric(&info, ink, direction);
+            }
+            times[b] = (int32)(GetEngineTime() - start);
+        }
 
-                case INK_MASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer == maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+        bool32 matches = !memcmp(frameBuffers[0], frameBuffers[1], screenWidth * SCREEN_YSIZE * sizeof(uint16));
+        PrintLog(PRINT_NORMAL, "Sprite blitters (%s, %d %dx%d sprites): generic %.3fms, templated %.3fms, %.2fx%s", inkNames[ink], spriteCount,
+                 spriteSize, spriteSize, times[0] / 1000.0f, times[1] / 1000.0f, times[1] ? (float)times[0] / times[1] : 0.0f,
+                 matches ? "" : ", OUTPUT DIFFERS");
+    }
 
-                case INK_UNMASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer != maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            ++pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-            }
+    RemoveStorageEntry((void **)&frameBuffers[0]);
+    RemoveStorageEntry((void **)&frameBuffers[1]);
+    RemoveStorageEntry((void **)&sheet);
+    RemoveStorageEntry((void **)&lineBuffer);
+}
+#endif
+
+void RSDK::DrawSpriteFlipped(int32 x, int32 y, int32 width, int32 height, int32 sprX, int32 sprY, int32 direction, int32 inkEffect, int32 alpha,
+                             int32 sheetID)
+{
+    switch (inkEffect) {
+        default: break;
+        case INK_ALPHA:
+            if (alpha > 0xFF)
+                inkEffect = INK_NONE;
+            else if (alpha <= 0)
+                return;
             break;
 
-        case FLIP_XY:
-            gfxPitch    = surface->width - width;
-            lineBuffer  = &gfxLineBuffer[y];
-            pixels      = &surface->pixels[widthFlip - 1 + sprX + surface->width * (sprY + heightFlip - 1)];
-            frameBuffer = &currentScreen->frameBuffer[x + currentScreen->pitch * y];
-            switch (inkEffect) {
-                case INK_NONE:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = activePalette[*pixels];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+        case INK_ADD:
+        case INK_SUB:
+            if (alpha > 0xFF)
+                alpha = 0xFF;
+            else if (alpha <= 0)
+                return;
+            break;
 
-                case INK_BLEND:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                setPixelBlend(activePalette[*pixels], *frameBuffer);
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+        case INK_TINT:
+            if (!tintLookupTable)
+                return;
+            break;
+    }
+    int32 widthFlip  = width;
+    int32 heightFlip = height;
 
-                case INK_ALPHA: {
-                    uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                    uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAlpha(color, *frameBuffer, alpha);
-                            }
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-                }
+    if (width + x > currentScreen->clipBound_X2)
+        width = currentScreen->clipBound_X2 - x;
 
-                case INK_ADD: {
-                    uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelAdditive(color, *frameBuffer);
-                            }
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-                }
+    if (x < currentScreen->clipBound_X1) {
+        int32 val = x - currentScreen->clipBound_X1;
+        sprX -= val;
+        width += val;
+        widthFlip += 2 * val;
+        x = currentScreen->clipBound_X1;
+    }
 
-                case INK_SUB: {
-                    uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0) {
-                                uint16 color = activePalette[*pixels];
-                                setPixelSubtractive(color, *frameBuffer);
-                            }
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-                }
+    if (height + y > currentScreen->clipBound_Y2)
+        height = currentScreen->clipBound_Y2 - y;
 
-                case INK_TINT:
-                    while (height--) {
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0)
-                                *frameBuffer = tintLookupTable[*frameBuffer];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+    if (y < currentScreen->clipBound_Y1) {
+        int32 val = y - currentScreen->clipBound_Y1;
+        sprY -= val;
+        height += val;
+        heightFlip += 2 * val;
+        y = currentScreen->clipBound_Y1;
+    }
 
-                case INK_MASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer == maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
+    if (width <= 0 || height <= 0)
+        return;
 
-                case INK_UNMASKED:
-                    while (height--) {
-                        uint16 *activePalette = fullPalette[*lineBuffer];
-                        lineBuffer++;
-                        int32 w = width;
-                        while (w--) {
-                            if (*pixels > 0 && *frameBuffer != maskColor)
-                                *frameBuffer = activePalette[*pixels];
-                            --pixels;
-                            ++frameBuffer;
-                        }
-                        frameBuffer += pitch;
-                        pixels -= gfxPitch;
-                    }
-                    break;
-            }
+    GFXSurface *surface = &gfxSurface[sheetID];
+    validDraw           = true;
+
+    if ((uint32)inkEffect > INK_UNMASKED || (uint32)direction > FLIP_XY)
+        return;
+
+#if !RETRO_USE_ORIGINAL_CODE
+    int32 spanRow      = (direction & FLIP_Y) ? (sprY + heightFlip - 1) : sprY;
+    int32 spanColStart = (direction & FLIP_X) ? (sprX + widthFlip - width) : sprX;
+    int32 spanRowEnd   = (direction & FLIP_Y) ? (spanRow - height + 1) : (spanRow + height - 1);
+
+    // the span path only handles frames that are fully inside the sheet
+    if (surface->spanTable && spanColStart >= 0 && spanColStart + width <= surface->width && MIN(spanRow, spanRowEnd) >= 0
+        && MAX(spanRow, spanRowEnd) < surface->height) {
+        SpriteSpanBlitInfo spanInfo;
+        spanInfo.frameBuffer = &currentScreen->frameBuffer[x + currentScreen->pitch * y];
+        spanInfo.lineBuffer  = &gfxLineBuffer[y];
+        spanInfo.surface     = surface;
+        spanInfo.height      = height;
+        spanInfo.pitch       = currentScreen->pitch;
+        spanInfo.row         = spanRow;
+        spanInfo.colStart    = spanColStart;
+        spanInfo.colEnd      = spanColStart + width;
+        spanInfo.alpha       = alpha;
+        SetupSpriteInkTables(inkEffect, alpha, &spanInfo.blendTable, &spanInfo.fbufferBlend);
+
+        spriteSpanBlitters[inkEffect][direction](&spanInfo);
+        return;
+    }
+#endif
+
+    SpriteBlitInfo info;
+    info.width       = width;
+    info.height      = height;
+    info.pitch       = currentScreen->pitch - width;
+    info.lineBuffer  = &gfxLineBuffer[y];
+    info.frameBuffer = &currentScreen->frameBuffer[x + currentScreen->pitch * y];
+    info.alpha       = alpha;
+    SetupSpriteInkTables(inkEffect, alpha, &info.blendTable, &info.fbufferBlend);
+
+    switch (direction) {
+        default: break;
+
+        case FLIP_NONE:
+            info.gfxPitch = surface->width - width;
+            info.pixels   = &surface->pixels[sprX + surface->width * sprY];
+            break;
+
+        case FLIP_X:
+            info.gfxPitch = width + surface->width;
+            info.pixels   = &surface->pixels[widthFlip - 1 + sprX + surface->width * sprY];
+            break;
+
+        case FLIP_Y:
+            info.gfxPitch = width + surface->width;
+            info.pixels   = &surface->pixels[sprX + surface->width * (sprY + heightFlip - 1)];
+            break;
+
+        case FLIP_XY:
+            info.gfxPitch = surface->width - width;
+            info.pixels   = &surface->pixels[widthFlip - 1 + sprX + surface->width * (sprY + heightFlip - 1)];
             break;
     }
+
+    spriteFlippedBlitters[inkEffect][direction](&info);
 }
 void RSDK::DrawSpriteRotozoom(int32 x, int32 y, int32 pivotX, int32 pivotY, int32 width, int32 height, int32 sprX, int32 sprY, int32 scaleX,
                               int32 scaleY, int32 direction, int16 rotation, int32 inkEffect, int32 alpha, int32 sheetID)
@@ -3838,24 +4165,17 @@ void RSDK::DrawSpriteRotozoom(int32 x, int32 y, int32 pivotX, int32 pivotY, int3
     if (xSize >= 1 && ySize >= 1) {
         GFXSurface *surface = &gfxSurface[sheetID];
 
-        int32 fullX         = TO_FIXED(sprX + width);
-        int32 fullY         = TO_FIXED(sprY + height);
-        validDraw           = true;
-        int32 fullScaleX    = (int32)((512.0 / (float)scaleX) * 512.0);
-        int32 fullScaleY    = (int32)((512.0 / (float)scaleY) * 512.0);
-        int32 deltaXLen     = fullScaleX * sine >> 2;
-        int32 deltaX        = fullScaleX * cosine >> 2;
-        int32 pitch         = currentScreen->pitch - xSize;
-        int32 deltaYLen     = fullScaleY * cosine >> 2;
-        int32 deltaY        = fullScaleY * sine >> 2;
-        int32 lineSize      = surface->lineSize;
-        uint8 *lineBuffer   = &gfxLineBuffer[top];
-        int32 xLen          = left - x;
-        int32 yLen          = top - y;
-        uint8 *pixels       = surface->pixels;
-        uint16 *frameBuffer = &currentScreen->frameBuffer[left + (top * currentScreen->pitch)];
-        int32 fullSprX      = TO_FIXED(sprX) - 1;
-        int32 fullSprY      = TO_FIXED(sprY) - 1;
+        int32 fullX      = TO_FIXED(sprX + width);
+        int32 fullY      = TO_FIXED(sprY + height);
+        validDraw        = true;
+        int32 fullScaleX = (int32)((512.0 / (float)scaleX) * 512.0);
+        int32 fullScaleY = (int32)((512.0 / (float)scaleY) * 512.0);
+        int32 deltaXLen  = fullScaleX * sine >> 2;
+        int32 deltaX     = fullScaleX * cosine >> 2;
+        int32 deltaYLen  = fullScaleY * cosine >> 2;
+        int32 deltaY     = fullScaleY * sine >> 2;
+        int32 xLen       = left - x;
+        int32 yLen       = top - y;
 
         int32 drawX = 0, drawY = 0;
         if (direction == FLIP_X) {
@@ -3869,201 +4189,30 @@ void RSDK::DrawSpriteRotozoom(int32 x, int32 y, int32 pivotX, int32 pivotY, int3
             drawY = sprYPos + deltaYLen * yLen + deltaY * xLen;
         }
 
-        switch (inkEffect) {
-            case INK_NONE:
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index)
-                                *frameBuffer = activePalette[index];
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-
-            case INK_BLEND:
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index)
-                                setPixelBlend(activePalette[index], *frameBuffer);
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-
-            case INK_ALPHA: {
-                uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-                uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index) {
-                                setPixelAlpha(activePalette[index], *frameBuffer, alpha);
-                            }
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-            }
-
-            case INK_ADD: {
-                uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index) {
-                                setPixelAdditive(activePalette[index], *frameBuffer);
-                            }
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-            }
-
-            case INK_SUB: {
-                uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index) {
-                                setPixelSubtractive(activePalette[index], *frameBuffer);
-                            }
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-            }
-
-            case INK_TINT:
-                for (int32 y = 0; y < ySize; ++y) {
-                    int32 drawXPos = drawX;
-                    int32 drawYPos = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index)
-                                *frameBuffer = tintLookupTable[*frameBuffer];
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-
-            case INK_MASKED:
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index && *frameBuffer == maskColor)
-                                *frameBuffer = activePalette[index];
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
-
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-
-            case INK_UNMASKED:
-                for (int32 y = 0; y < ySize; ++y) {
-                    uint16 *activePalette = fullPalette[*lineBuffer++];
-                    int32 drawXPos        = drawX;
-                    int32 drawYPos        = drawY;
-                    for (int32 x = 0; x < xSize; ++x) {
-                        if (drawXPos >= fullSprX && drawXPos < fullX && drawYPos >= fullSprY && drawYPos < fullY) {
-                            uint8 index = pixels[(FROM_FIXED(drawYPos) << lineSize) + FROM_FIXED(drawXPos)];
-                            if (index && *frameBuffer != maskColor)
-                                *frameBuffer = activePalette[index];
-                        }
-
-                        ++frameBuffer;
-                        drawXPos += deltaX;
-                        drawYPos += deltaY;
-                    }
+        if ((uint32)inkEffect > INK_UNMASKED)
+            return;
 
-                    drawX -= deltaXLen;
-                    drawY += deltaYLen;
-                    frameBuffer += pitch;
-                }
-                break;
-        }
+        SpriteRotozoomBlitInfo info;
+        info.frameBuffer = &currentScreen->frameBuffer[left + (top * currentScreen->pitch)];
+        info.pixels      = surface->pixels;
+        info.lineBuffer  = &gfxLineBuffer[top];
+        info.width       = xSize;
+        info.height      = ySize;
+        info.pitch       = currentScreen->pitch - xSize;
+        info.lineSize    = surface->lineSize;
+        info.drawX       = drawX;
+        info.drawY       = drawY;
+        info.deltaX      = deltaX;
+        info.deltaY      = deltaY;
+        info.deltaXLen   = deltaXLen;
+        info.deltaYLen   = deltaYLen;
+        info.fullSprX    = TO_FIXED(sprX) - 1;
+        info.fullSprY    = TO_FIXED(sprY) - 1;
+        info.fullX       = fullX;
+        info.fullY       = fullY;
+        SetupSpriteInkTables(inkEffect, alpha, &info.blendTable, &info.fbufferBlend);
+
+        spriteRotozoomBlitters[inkEffect](&info);
     }
 }
 
@@ -4092,186 +4241,26 @@ void RSDK::DrawDeformedSprite(uint16 sheetID, int32 inkEffect, int32 alpha)
             break;
     }
 
-    validDraw              = true;
-    GFXSurface *surface    = &gfxSurface[sheetID];
-    uint8 *pixels          = surface->pixels;
-    int32 clipY1           = currentScreen->clipBound_Y1;
-    ScanlineInfo *scanline = &scanlines[clipY1];
-    uint16 *frameBuffer    = &currentScreen->frameBuffer[clipY1 * currentScreen->pitch];
-    uint8 *lineBuffer      = &gfxLineBuffer[clipY1];
-    int32 width            = surface->width - 1;
-    int32 height           = surface->height - 1;
-    int32 lineSize         = surface->lineSize;
-
-    switch (inkEffect) {
-        case INK_NONE:
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex)
-                        *frameBuffer = activePalette[palIndex];
-
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
-
-        case INK_BLEND:
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex)
-                        setPixelBlend(activePalette[palIndex], *frameBuffer);
-
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
-
-        case INK_ALPHA: {
-            uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
-            uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
-
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex) {
-                        setPixelAlpha(activePalette[palIndex], *frameBuffer, alpha);
-                    }
-
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
-        }
-
-        case INK_ADD: {
-            uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
-
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex) {
-                        setPixelAdditive(activePalette[palIndex], *frameBuffer);
-                    }
-
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
-        }
-
-        case INK_SUB: {
-            uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
-
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex) {
-                        setPixelSubtractive(activePalette[palIndex], *frameBuffer);
-                    }
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
-        }
-
-        case INK_TINT:
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                int32 lx = scanline->position.x;
-                int32 ly = scanline->position.y;
-                int32 dx = scanline->deform.x;
-                int32 dy = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex)
-                        *frameBuffer = tintLookupTable[*frameBuffer];
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
+    validDraw           = true;
+    GFXSurface *surface = &gfxSurface[sheetID];
+    int32 clipY1        = currentScreen->clipBound_Y1;
 
-        case INK_MASKED:
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex && *frameBuffer == maskColor)
-                        *frameBuffer = activePalette[palIndex];
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
+    if ((uint32)inkEffect > INK_UNMASKED)
+        return;
 
-        case INK_UNMASKED:
-            for (; clipY1 < currentScreen->clipBound_Y2; ++clipY1) {
-                uint16 *activePalette = fullPalette[*lineBuffer++];
-                int32 lx              = scanline->position.x;
-                int32 ly              = scanline->position.y;
-                int32 dx              = scanline->deform.x;
-                int32 dy              = scanline->deform.y;
-                for (int32 i = 0; i < currentScreen->pitch; ++i) {
-                    uint8 palIndex = pixels[((FROM_FIXED(ly) & height) << lineSize) + (FROM_FIXED(lx) & width)];
-                    if (palIndex && *frameBuffer != maskColor)
-                        *frameBuffer = activePalette[palIndex];
-                    lx += dx;
-                    ly += dy;
-                    ++frameBuffer;
-                }
-                ++scanline;
-            }
-            break;
-    }
+    SpriteDeformBlitInfo info;
+    info.frameBuffer = &currentScreen->frameBuffer[clipY1 * currentScreen->pitch];
+    info.pixels      = surface->pixels;
+    info.lineBuffer  = &gfxLineBuffer[clipY1];
+    info.scanline    = &scanlines[clipY1];
+    info.lineCount   = currentScreen->clipBound_Y2 - clipY1;
+    info.pitch       = currentScreen->pitch;
+    info.width       = surface->width - 1;
+    info.height      = surface->height - 1;
+    info.lineSize    = surface->lineSize;
+    SetupSpriteInkTables(inkEffect, alpha, &info.blendTable, &info.fbufferBlend);
+
+    spriteDeformBlitters[inkEffect](&info);
 }
 
 void RSDK::DrawTile(uint16 *tiles, int32 countX, int32 countY, Vector2 *position, Vector2 *offset, bool32 screenRelative)
@@ -5,6 +5,10 @@ namespace RSDK
 {
 
 #define SURFACE_COUNT (0x40)
+#if !RETRO_USE_ORIGINAL_CODE
+// max bytes of opaque span tables across every surface, sheets past this just draw without one
+#define SURFACE_SPANTABLE_LIMIT (0x100000)
+#endif
 
 #ifndef SCREEN_COUNT
 #if RETRO_REV02
@@ -71,6 +75,11 @@ struct GFXSurface {
     int32 width;
     int32 lineSize;
     uint8 scope;
+#if !RETRO_USE_ORIGINAL_CODE
+    // (height + 1) row offsets followed by the opaque runs of every row, see BuildSurfaceSpans()
+    uint32 *spanTable;
+    int32 spanTableSize;
+#endif
 };
 
 struct ScreenInfo {
@@ -256,6 +265,8 @@ private:
 #include "Vulkan/VulkanRenderDevice.hpp"
 #elif RETRO_RENDERDEVICE_EGL
 #include "EGL/EGLRenderDevice.hpp"
+#elif RETRO_RENDERDEVICE_HEADLESS
+#include "Headless/HeadlessRenderDevice.hpp"
 #endif
 
 extern DrawList drawGroups[DRAWGROUP_COUNT];
@@ -270,7 +281,7 @@ extern float dpi;
 extern int32 cameraCount;
 extern ScreenInfo screens[SCREEN_COUNT];
 extern CameraInfo cameras[CAMERA_COUNT];
-extern ScreenInfo *currentScreen;
+extern RETRO_THREAD_LOCAL ScreenInfo *currentScreen;
 
 extern int32 shaderCount;
 extern ShaderEntry shaderList[SHADER_COUNT];
@@ -290,6 +301,10 @@ void UpdateGameWindow();
 void GenerateBlendLookupTable();
 
 void InitSystemSurfaces();
+#if !RETRO_USE_ORIGINAL_CODE
+void BuildSurfaceSpans(GFXSurface *surface);
+int32 GetSurfaceSpanBytes();
+#endif
 
 void GetDisplayInfo(int32 *displayID, int32 *width, int32 *height, int32 *refreshRate, char *text);
 void GetWindowSize(int32 *width, int32 *height);
@@ -373,6 +388,12 @@ inline void SetDrawGroupProperties(uint8 drawGroup, bool32 sorted, void (*hookCB
 }
 
 void SwapDrawListEntries(uint8 drawGroup, uint16 slot1, uint16 slot2, uint16 count);
+// sorts a draw list by zdepth (highest first), entries with the same zdepth keep their order
+void SortDrawList(DrawList *list);
+#if !RETRO_USE_ORIGINAL_CODE
+// times SortDrawList against the bubble sort it replaced with 500/1000/2000 entities in one group
+void BenchmarkDrawListSort();
+#endif
 
 void FillScreen(uint32 color, int32 alphaR, int32 alphaG, int32 alphaB);
 
@@ -391,6 +412,10 @@ void DrawSpriteRotozoom(int32 x, int32 y, int32 pivotX, int32 pivotY, int32 widt
                         int32 direction, int16 Rotation, int32 inkEffect, int32 alpha, int32 sheetID);
 
 void DrawDeformedSprite(uint16 sheetID, int32 inkEffect, int32 alpha);
+#if !RETRO_USE_ORIGINAL_CODE
+// times the templated DrawSpriteFlipped blitters against a single loop that switches on ink & flip, 10k sprites per ink
+void BenchmarkSpriteBlitters();
+#endif
 
 void DrawTile(uint16 *tileInfo, int32 countX, int32 countY, Vector2 *position, Vector2 *offset, bool32 screenRelative);
 void DrawAniTile(uint16 sheetID, uint16 tileIndex, uint16 srcX, uint16 srcY, uint16 width, uint16 height);
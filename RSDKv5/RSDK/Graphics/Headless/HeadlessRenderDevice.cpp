@@ -0,0 +1,248 @@
+#include <chrono>
+
+int32 RenderDevice::dumpInterval = 0;
+int32 RenderDevice::dumpFormat   = HEADLESS_DUMP_PNG;
+int32 RenderDevice::frameLimit   = 0;
+bool32 RenderDevice::uncapped    = false;
+
+uint32 RenderDevice::frameCount = 0;
+
+int64 RenderDevice::targetFreq = 0;
+int64 RenderDevice::curTicks   = 0;
+int64 RenderDevice::prevTicks  = 0;
+int64 RenderDevice::startTicks = 0;
+
+static inline int64 GetHeadlessTicks()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool RenderDevice::Init()
+{
+    // there's no window to size, so just act like a fullscreen-less windowed device
+    videoSettings.windowed    = true;
+    videoSettings.exclusiveFS = false;
+
+    if (!InitGraphicsAPI() || !InitShaders() || !AudioDevice::Init())
+        return false;
+
+    int32 size = videoSettings.pixWidth >= SCREEN_YSIZE ? videoSettings.pixWidth : SCREEN_YSIZE;
+    scanlines  = (ScanlineInfo *)malloc(size * sizeof(ScanlineInfo));
+    memset(scanlines, 0, size * sizeof(ScanlineInfo));
+
+    videoSettings.windowState = WINDOWSTATE_ACTIVE;
+    videoSettings.dimMax      = 1.0;
+    videoSettings.dimPercent  = 1.0;
+
+    frameCount = 0;
+    startTicks = GetHeadlessTicks();
+
+    InitInputDevices();
+    return true;
+}
+
+void RenderDevice::CopyFrameBuffer()
+{
+    // the software renderer already did all the work, the only thing left to do is optionally save the result
+    if (!dumpInterval || (frameCount % dumpInterval))
+        return;
+
+    for (int32 s = 0; s < videoSettings.screenCount; ++s) DumpScreen(s);
+}
+
+void RenderDevice::DumpScreen(int32 screenID)
+{
+    ScreenInfo *screen = &screens[screenID];
+    int32 width        = screen->size.x;
+    int32 height       = screen->size.y;
+
+    char fileName[0x40];
+    if (dumpFormat == HEADLESS_DUMP_RAW)
+        sprintf_s(fileName, sizeof(fileName), "frame%06u_%d_%dx%d.raw", frameCount, screenID, width, height);
+    else
+        sprintf_s(fileName, sizeof(fileName), "frame%06u_%d.png", frameCount, screenID);
+
+    FileIO *file = fOpen(fileName, "wb");
+    if (!file) {
+        PrintLog(PRINT_NORMAL, "ERROR: failed to open %s for writing!", fileName);
+        return;
+    }
+
+    uint16 *frameBuffer = screen->frameBuffer;
+    if (dumpFormat == HEADLESS_DUMP_RAW) {
+        for (int32 y = 0; y < height; ++y) {
+            fWrite(frameBuffer, sizeof(uint16), width, file);
+            frameBuffer += screen->pitch;
+        }
+    }
+    else {
+        uint8 *pixels = (uint8 *)malloc(width * height * 3);
+        uint8 *pixel  = pixels;
+        for (int32 y = 0; y < height; ++y) {
+            for (int32 x = 0; x < width; ++x) {
+                uint16 color = frameBuffer[x];
+
+                // expand 5 bits to 8 by repeating the top bits so 0x1F maps to 0xFF
+                uint8 r  = (color >> 10) & 0x1F;
+                uint8 g  = (color >> 5) & 0x1F;
+                uint8 b  = color & 0x1F;
+                *pixel++ = (r << 3) | (r >> 2);
+                *pixel++ = (g << 3) | (g >> 2);
+                *pixel++ = (b << 3) | (b >> 2);
+            }
+
+            frameBuffer += screen->pitch;
+        }
+
+        size_t pngSize = 0;
+        void *png      = tdefl_write_image_to_png_file_in_memory(pixels, width, height, 3, &pngSize);
+        if (png) {
+            fWrite(png, 1, pngSize, file);
+            mz_free(png);
+        }
+        else {
+            PrintLog(PRINT_NORMAL, "ERROR: failed to encode %s!", fileName);
+        }
+
+        free(pixels);
+    }
+
+    fClose(file);
+}
+
+void RenderDevice::FlipScreen()
+{
+    if (windowRefreshDelay > 0) {
+        windowRefreshDelay--;
+        if (!windowRefreshDelay)
+            UpdateGameWindow();
+        return;
+    }
+
+    ++frameCount;
+    if (frameLimit && frameCount >= (uint32)frameLimit)
+        isRunning = false;
+}
+
+void RenderDevice::Release(bool32 isRefresh)
+{
+    if (!isRefresh) {
+        int64 elapsed = GetHeadlessTicks() - startTicks;
+        if (elapsed > 0)
+            PrintLog(PRINT_NORMAL, "Ran %u frames in %.3fs (%.2f fps)", frameCount, elapsed / 1000000000.0, frameCount * 1000000000.0 / elapsed);
+
+        if (scanlines)
+            free(scanlines);
+        scanlines = NULL;
+    }
+}
+
+void RenderDevice::RefreshWindow()
+{
+    videoSettings.windowState = WINDOWSTATE_UNINITIALIZED;
+
+    Release(true);
+
+    if (!InitGraphicsAPI() || !InitShaders())
+        return;
+
+    videoSettings.windowState = WINDOWSTATE_ACTIVE;
+}
+
+void RenderDevice::GetWindowSize(int32 *width, int32 *height)
+{
+    if (width)
+        *width = videoSettings.windowWidth;
+
+    if (height)
+        *height = videoSettings.windowHeight;
+}
+
+bool RenderDevice::InitGraphicsAPI()
+{
+    videoSettings.shaderSupport = false;
+
+    viewSize.x = videoSettings.windowWidth;
+    viewSize.y = videoSettings.windowHeight;
+    if (viewSize.x <= 0 || viewSize.y <= 0) {
+        viewSize.x = videoSettings.pixWidth;
+        viewSize.y = SCREEN_YSIZE;
+    }
+
+    displayCount = 0;
+
+#if !RETRO_USE_ORIGINAL_CODE
+    int32 screenWidth = 0;
+#endif
+    for (int32 s = 0; s < 4; ++s) {
+        screens[s].size.y = videoSettings.pixHeight;
+
+        float viewAspect = viewSize.x / viewSize.y;
+#if !RETRO_USE_ORIGINAL_CODE
+        screenWidth = (int32)((viewAspect * videoSettings.pixHeight) + 3) & 0xFFFFFFFC;
+#else
+        int32 screenWidth = (int32)((viewAspect * videoSettings.pixHeight) + 3) & 0xFFFFFFFC;
+#endif
+        if (screenWidth < videoSettings.pixWidth)
+            screenWidth = videoSettings.pixWidth;
+
+#if !RETRO_USE_ORIGINAL_CODE
+        if (customSettings.maxPixWidth && screenWidth > customSettings.maxPixWidth)
+            screenWidth = customSettings.maxPixWidth;
+#else
+        if (screenWidth > DEFAULT_PIXWIDTH)
+            screenWidth = DEFAULT_PIXWIDTH;
+#endif
+
+        memset(&screens[s].frameBuffer, 0, sizeof(screens[s].frameBuffer));
+        SetScreenSize(s, screenWidth, screens[s].size.y);
+    }
+
+    pixelSize.x = screens[0].size.x;
+    pixelSize.y = screens[0].size.y;
+
+    lastShaderID            = -1;
+    engine.inFocus          = 1;
+    videoSettings.viewportX = 0;
+    videoSettings.viewportY = 0;
+    videoSettings.viewportW = 1.0 / viewSize.x;
+    videoSettings.viewportH = 1.0 / viewSize.y;
+
+    return true;
+}
+
+void RenderDevice::LoadShader(const char *, bool32) { PrintLog(PRINT_NORMAL, "This render device does not support shaders!"); }
+
+bool RenderDevice::InitShaders()
+{
+#if RETRO_USE_MOD_LOADER
+    shaderCount = 0;
+#endif
+
+    for (int32 s = 0; s < SHADER_COUNT; ++s) shaderList[s].linear = false;
+    shaderCount            = 1;
+    videoSettings.shaderID = 0;
+
+    return true;
+}
+
+bool RenderDevice::ProcessEvents() { return isRunning; }
+
+void RenderDevice::InitFPSCap()
+{
+    targetFreq = 1000000000LL / (videoSettings.refreshRate > 0 ? videoSettings.refreshRate : 60);
+    curTicks   = 0;
+    prevTicks  = 0;
+}
+bool RenderDevice::CheckFPSCap()
+{
+    if (uncapped)
+        return true;
+
+    curTicks = GetHeadlessTicks();
+    if (curTicks >= prevTicks + targetFreq)
+        return true;
+
+    return false;
+}
+void RenderDevice::UpdateFPSCap() { prevTicks = curTicks; }
@@ -0,0 +1,63 @@
+using ShaderEntry = ShaderEntryBase;
+
+enum HeadlessDumpFormats {
+    HEADLESS_DUMP_RAW, // raw RGB555 pixels, the size is written into the file name
+    HEADLESS_DUMP_PNG,
+};
+
+class RenderDevice : public RenderDeviceBase
+{
+public:
+    struct WindowInfo {
+        struct {
+            int32 width;
+            int32 height;
+            int32 refresh_rate;
+        } * displays;
+    };
+    static WindowInfo displayInfo;
+
+    static bool Init();
+    static void CopyFrameBuffer();
+    static void FlipScreen();
+    static void Release(bool32 isRefresh);
+
+    static void RefreshWindow();
+    static void GetWindowSize(int32 *width, int32 *height);
+
+    static void SetupImageTexture(int32, int32, uint8 *) {}
+    static void SetupVideoTexture_YUV420(int32, int32, uint8 *, uint8 *, uint8 *, int32, int32, int32) {}
+    static void SetupVideoTexture_YUV422(int32, int32, uint8 *, uint8 *, uint8 *, int32, int32, int32) {}
+    static void SetupVideoTexture_YUV444(int32, int32, uint8 *, uint8 *, uint8 *, int32, int32, int32) {}
+
+    static bool ProcessEvents();
+
+    static void InitFPSCap();
+    static bool CheckFPSCap();
+    static void UpdateFPSCap();
+
+    static bool InitShaders();
+    static void LoadShader(const char *fileName, bool32 linear);
+
+    static inline void ShowCursor(bool32) {}
+    static inline bool GetCursorPos(Vector2 *) { return false; }
+    static inline void SetWindowTitle() {}
+
+    // set from the command line (dumpframes=, dumpformat=raw, framelimit=, uncapped=true), see ParseArguments()
+    static int32 dumpInterval; // dump every Nth frame, 0 disables dumping
+    static int32 dumpFormat;
+    static int32 frameLimit; // quit after this many frames, 0 runs until the game exits
+    static bool32 uncapped;  // run frames back to back instead of at videoSettings.refreshRate
+
+    static uint32 frameCount;
+
+private:
+    static bool InitGraphicsAPI();
+
+    static void DumpScreen(int32 screenID);
+
+    static int64 targetFreq;
+    static int64 curTicks;
+    static int64 prevTicks;
+    static int64 startTicks;
+};
@@ -17,7 +17,13 @@ uint16 RSDK::stagePalette[PALETTE_BANK_COUNT][PALETTE_BANK_SIZE];
 
 uint16 RSDK::fullPalette[PALETTE_BANK_COUNT][PALETTE_BANK_SIZE];
 
+#if RETRO_USE_THREADS
+static uint8 mainLineBuffer[SCREEN_YSIZE];
+thread_local uint8 *RSDK::gfxLineBuffer = mainLineBuffer;
+thread_local uint16 (*RSDK::layerPalette)[PALETTE_BANK_SIZE] = RSDK::fullPalette;
+#else
 uint8 RSDK::gfxLineBuffer[SCREEN_YSIZE];
+#endif
 
 int32 RSDK::maskColor = 0;
 #if RETRO_REV02
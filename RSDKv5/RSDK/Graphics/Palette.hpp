@@ -23,7 +23,15 @@ extern uint16 stagePalette[PALETTE_BANK_COUNT][PALETTE_BANK_SIZE];
 
 extern uint16 fullPalette[PALETTE_BANK_COUNT][PALETTE_BANK_SIZE];
 
+#if RETRO_USE_THREADS
+// points to the main line buffer, or a screen's own copy while screens are drawn in parallel
+extern thread_local uint8 *gfxLineBuffer;
+// the banks tile layers are drawn with, fullPalette or a screen's own snapshot while screens are drawn in parallel
+extern thread_local uint16 (*layerPalette)[PALETTE_BANK_SIZE];
+#else
 extern uint8 gfxLineBuffer[SCREEN_YSIZE];
+#define layerPalette fullPalette
+#endif
 
 extern int32 maskColor;
 
@@ -11,6 +11,17 @@ Scene3D RSDK::scene3DList[SCENE3D_COUNT];
 
 ScanEdge RSDK::scanEdgeBuffer[SCREEN_YSIZE * 2];
 
+#if !RETRO_USE_ORIGINAL_CODE
+Scene3DStats RSDK::scene3DStats[SCENE3D_COUNT];
+#endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+// face buffers this size or smaller are cheaper to insertion sort than to radix sort
+#define FACEBUFFER_INSERTIONSORT_MAX (0x40)
+
+static Scene3DFace faceSortBuffer[SCENE3D_VERT_COUNT];
+#endif
+
 enum ModelFlags {
     MODEL_NOFLAGS     = 0,
     MODEL_USENORMALS  = 1 << 0,
@@ -823,6 +834,146 @@ void RSDK::AddMeshFrameToScene(uint16 modelFrames, uint16 sceneIndex, Animator *
     }
 }
 
+void RSDK::SortFaceBuffer(Scene3DFace *faces, int32 count)
+{
+#if !RETRO_USE_ORIGINAL_CODE
+    if (count <= FACEBUFFER_INSERTIONSORT_MAX) {
+        for (int32 i = 1; i < count; ++i) {
+            Scene3DFace face = faces[i];
+
+            int32 pos = i;
+            for (; pos > 0 && faces[pos - 1].depth < face.depth; --pos) faces[pos] = faces[pos - 1];
+            faces[pos] = face;
+        }
+        return;
+    }
+
+    // LSD radix sort, flipping the sign bit makes the depths sort as unsigned & inverting them puts the furthest face first
+    int32 offsets[4][0x100];
+    memset(offsets, 0, sizeof(offsets));
+    for (int32 i = 0; i < count; ++i) {
+        uint32 key = ~((uint32)faces[i].depth ^ 0x80000000);
+        offsets[0][(key >> 0) & 0xFF]++;
+        offsets[1][(key >> 8) & 0xFF]++;
+        offsets[2][(key >> 16) & 0xFF]++;
+        offsets[3][(key >> 24) & 0xFF]++;
+    }
+
+    Scene3DFace *src  = faces;
+    Scene3DFace *dest = faceSortBuffer;
+    uint32 firstKey   = ~((uint32)faces[0].depth ^ 0x80000000);
+    for (int32 p = 0; p < 4; ++p) {
+        int32 shift    = p * 8;
+        int32 *offsetP = offsets[p];
+
+        // every depth has the same byte here, so this pass wouldn't move anything
+        if (offsetP[(firstKey >> shift) & 0xFF] == count)
+            continue;
+
+        int32 total = 0;
+        for (int32 b = 0; b < 0x100; ++b) {
+            int32 size = offsetP[b];
+            offsetP[b] = total;
+            total += size;
+        }
+
+        for (int32 i = 0; i < count; ++i) {
+            uint32 key = ~((uint32)src[i].depth ^ 0x80000000);
+            dest[offsetP[(key >> shift) & 0xFF]++] = src[i];
+        }
+
+        Scene3DFace *swap = src;
+        src               = dest;
+        dest              = swap;
+    }
+
+    if (src != faces)
+        memcpy(faces, src, count * sizeof(Scene3DFace));
+#else
+    // This is an insertion sort, taken from here:
+    // https://web.archive.org/web/20110108233032/http://rosettacode.org/wiki/Sorting_algorithms/Insertion_sort#C
+
+    Scene3DFace *a = faces;
+
+    int i, j;
+    Scene3DFace temp;
+
+    for(i=1; i<count; i++)
+    {
+        temp = a[i];
+        j = i-1;
+        while(j>=0 && a[j].depth < temp.depth)
+        {
+            a[j+1] = a[j];
+            j -= 1;
+        }
+        a[j+1] = temp;
+    }
+#endif
+}
+
+#if !RETRO_USE_ORIGINAL_CODE
+// returns true if the face can't be seen on the current screen
+static bool32 Cull3DFace(Scene3D *scn, Scene3DVertex *vertices, int32 vertCount, int32 cullFlags)
+{
+    if (vertCount <= 0)
+        return false;
+
+    // screen positions in 24.8 fixed point
+    int32 screenX[0x100];
+    int32 screenY[0x100];
+    if (scn->drawMode >= S3D_WIREFRAME_SCREEN) {
+        for (int32 v = 0; v < vertCount; ++v) {
+            int32 vertZ = vertices[v].z;
+            // the draw loop skips any face that crosses the near plane
+            if (vertZ < 0x100)
+                return (cullFlags & S3D_CULL_OFFSCREEN) != 0;
+
+            screenX[v] = (currentScreen->center.x << 8) + ((vertices[v].x << scn->projectionX) / vertZ << 8);
+            screenY[v] = (currentScreen->center.y << 8) - ((vertices[v].y << scn->projectionY) / vertZ << 8);
+        }
+    }
+    else {
+        for (int32 v = 0; v < vertCount; ++v) {
+            screenX[v] = vertices[v].x - (currentScreen->position.x << 8);
+            screenY[v] = vertices[v].y - (currentScreen->position.y << 8);
+        }
+    }
+
+    if (cullFlags & S3D_CULL_OFFSCREEN) {
+        int32 outside = 0xF;
+        for (int32 v = 0; v < vertCount; ++v) {
+            int32 code = 0;
+            if (screenX[v] < (currentScreen->clipBound_X1 << 8))
+                code |= 1;
+            if (screenX[v] >= (currentScreen->clipBound_X2 << 8))
+                code |= 2;
+            if (screenY[v] < (currentScreen->clipBound_Y1 << 8))
+                code |= 4;
+            if (screenY[v] >= (currentScreen->clipBound_Y2 << 8))
+                code |= 8;
+            outside &= code;
+        }
+
+        // every vertex is past the same screen edge
+        if (outside)
+            return true;
+    }
+
+    if ((cullFlags & S3D_CULL_BACKFACES) && vertCount >= 3) {
+        // faces wound anti-clockwise on screen are facing away
+        int64 area = 0;
+        for (int32 v = 0, prev = vertCount - 1; v < vertCount; prev = v++)
+            area += (int64)screenX[prev] * screenY[v] - (int64)screenX[v] * screenY[prev];
+
+        if (area < 0)
+            return true;
+    }
+
+    return false;
+}
+#endif
+
 void RSDK::Draw3DScene(uint16 sceneID)
 {
     if (sceneID < SCENE3D_COUNT) {
@@ -833,10 +984,19 @@ void RSDK::Draw3DScene(uint16 sceneID)
         // Each face's depth is an average of the depth of its vertices.
         Scene3DVertex *vertices = scn->vertices;
         Scene3DFace *faceBuffer = scn->faceBuffer;
-        uint8 *faceVertCounts = scn->faceVertCounts;
+        uint8 *faceVertCounts   = scn->faceVertCounts;
 
+#if !RETRO_USE_ORIGINAL_CODE
+        int32 cullFlags = customSettings.faceCulling;
+#endif
+
+        int32 faceCount = 0;
         int32 vertIndex = 0;
         for (int32 i = 0; i < scn->faceCount; ++i) {
+#if !RETRO_USE_ORIGINAL_CODE
+            Scene3DVertex *faceVertices = vertices;
+#endif
+
             switch (*faceVertCounts) {
                 default:
                 case 1:
@@ -869,30 +1029,27 @@ void RSDK::Draw3DScene(uint16 sceneID)
             faceBuffer->index = vertIndex;
             vertIndex += *faceVertCounts;
 
+#if !RETRO_USE_ORIGINAL_CODE
+            // culled faces are left out of the buffer, the next face overwrites this slot
+            if (cullFlags && Cull3DFace(scn, faceVertices, *faceVertCounts, cullFlags)) {
+                ++faceVertCounts;
+                continue;
+            }
+#endif
+
             ++faceBuffer;
+            ++faceCount;
             ++faceVertCounts;
         }
 
-        // Sort the face buffer. This is needed so that the faces don't overlap each other incorrectly when they're rendered.
-        // This is an insertion sort, taken from here:
-        // https://web.archive.org/web/20110108233032/http://rosettacode.org/wiki/Sorting_algorithms/Insertion_sort#C
-
-        Scene3DFace *a = scn->faceBuffer;
-
-        int i, j;
-        Scene3DFace temp;
+#if !RETRO_USE_ORIGINAL_CODE
+        scene3DStats[sceneID].faceCount   = scn->faceCount;
+        scene3DStats[sceneID].drawnFaces  = faceCount;
+        scene3DStats[sceneID].culledFaces = scn->faceCount - faceCount;
+#endif
 
-        for(i=1; i<scn->faceCount; i++)
-        {
-            temp = a[i];
-            j = i-1;
-            while(j>=0 && a[j].depth < temp.depth)
-            {
-                a[j+1] = a[j];
-                j -= 1;
-            }
-            a[j+1] = temp;
-        }
+        // Sort the face buffer. This is needed so that the faces don't overlap each other incorrectly when they're rendered.
+        SortFaceBuffer(scn->faceBuffer, faceCount);
 
         // Finally, display the faces.
 
@@ -904,7 +1061,7 @@ void RSDK::Draw3DScene(uint16 sceneID)
             default: break;
 
             case S3D_WIREFRAME:
-                for (int32 f = 0; f < scn->faceCount; ++f) {
+                for (int32 f = 0; f < faceCount; ++f) {
                     Scene3DVertex *drawVert = &scn->vertices[scn->faceBuffer[f].index];
                     for (int32 v = 0; v < *vertCnt - 1; ++v) {
                         DrawLine(drawVert[v + 0].x << 8, drawVert[v + 0].y << 8, drawVert[v + 1].x << 8, drawVert[v + 1].y << 8, drawVert[0].color,
@@ -917,7 +1074,7 @@ void RSDK::Draw3DScene(uint16 sceneID)
                 break;
 
             case S3D_SOLIDCOLOR:
-                for (int32 f = 0; f < scn->faceCount; ++f) {
+                for (int32 f = 0; f < faceCount; ++f) {
                     Scene3DVertex *drawVert = &scn->vertices[scn->faceBuffer[f].index];
                     for (int32 v = 0; v < *vertCnt; ++v) {
                         vertPos[v].x = (drawVert[v].x << 8) - (currentScreen->position.x << 16);
@@ -935,7 +1092,7 @@ void RSDK::Draw3DScene(uint16 sceneID)
             case S3D_UNUSED_2: break;
 
             case S3D_WIREFRAME_SHADED:
-                for (int32 f = 0; f < scn->faceCount; ++f) {
+                for (int32 f = 0; f < faceCount; ++f) {
                     Scene3DVertex *drawVert = &scn->vertices[scn->faceBuffer[f].index];
                     int32 vertCount         = *vertCnt;
 
@@ -977,7 +1134,7 @@ void RSDK::Draw3DScene(uint16 sceneID)
                 break;
 
             case S3D_SOLIDCOLOR_SHADED:
-                for (int32 f = 0; f < scn->faceCount; ++f) {
+                for (int32 f = 0; f < faceCount; ++f) {
                     Scene3DVertex *drawVert = &scn->vertices[scn->faceBuffer[f].index];
                     int32 vertCount         = *vertCnt;
 
@@ -1017,7 +1174,7 @@ void RSDK::Draw3DScene(uint16 sceneID)
                 break;
 
             case S3D_SOLIDCOLOR_SHADED_BLENDED:
-                for (int32 f = 0; f < scn->faceCount; ++f) {
+                for (int32 f = 0; f < faceCount; ++f) {
                     Scene3DVertex *drawVert = &scn->vertices[scn->faceBuffer[f].index];
                     int32 vertCount         = *vertCnt;
 
@@ -1054,7 +1211,7 @@ void RSDK::Draw3DScene(uint16 sceneID)
                 break;
 
             case S3D_WIREFRAME_SCREEN:
-                for (int32 f = 0; f < scn->faceCount; ++f) {
+                for (int32 f = 0; f < faceCount; ++f) {
                     Scene3DVertex *drawVert = &scn->vertices[scn->faceBuffer[f].index];
 
                     int32 v = 0;
@@ -1083,7 +1240,7 @@ void RSDK::Draw3DScene(uint16 sceneID)
                 break;
 
             case S3D_SOLIDCOLOR_SCREEN:
-                for (int32 f = 0; f < scn->faceCount; ++f) {
+                for (int32 f = 0; f < faceCount; ++f) {
                     Scene3DVertex *drawVert = &scn->vertices[scn->faceBuffer[f].index];
                     int32 vertCount         = *vertCnt;
 
@@ -1108,7 +1265,7 @@ void RSDK::Draw3DScene(uint16 sceneID)
                 break;
 
             case S3D_WIREFRAME_SHADED_SCREEN:
-                for (int32 f = 0; f < scn->faceCount; ++f) {
+                for (int32 f = 0; f < faceCount; ++f) {
                     Scene3DVertex *drawVert = &scn->vertices[scn->faceBuffer[f].index];
                     int32 vertCount         = *vertCnt;
 
@@ -1161,7 +1318,7 @@ void RSDK::Draw3DScene(uint16 sceneID)
                 break;
 
             case S3D_SOLIDCOLOR_SHADED_SCREEN:
-                for (int32 f = 0; f < scn->faceCount; ++f) {
+                for (int32 f = 0; f < faceCount; ++f) {
                     Scene3DVertex *drawVert = &scn->vertices[scn->faceBuffer[f].index];
                     int32 vertCount         = *vertCnt;
 
@@ -1210,7 +1367,7 @@ void RSDK::Draw3DScene(uint16 sceneID)
                 break;
 
             case S3D_SOLIDCOLOR_SHADED_BLENDED_SCREEN:
-                for (int32 f = 0; f < scn->faceCount; ++f) {
+                for (int32 f = 0; f < faceCount; ++f) {
                     Scene3DVertex *drawVert = &scn->vertices[scn->faceBuffer[f].index];
                     int32 vertCount         = *vertCnt;
 
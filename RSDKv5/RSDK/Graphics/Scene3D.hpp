@@ -31,6 +31,21 @@ enum Scene3DDrawTypes {
     S3D_SOLIDCOLOR_SHADED_BLENDED_SCREEN,
 };
 
+#if !RETRO_USE_ORIGINAL_CODE
+enum Scene3DCullFlags {
+    S3D_CULL_NONE      = 0,
+    S3D_CULL_BACKFACES = 1 << 0,
+    S3D_CULL_OFFSCREEN = 1 << 1,
+};
+
+// face counts from the last Draw3DScene call for each scene
+struct Scene3DStats {
+    int32 faceCount;
+    int32 drawnFaces;
+    int32 culledFaces;
+};
+#endif
+
 struct ScanEdge {
     int32 start;
     int32 end;
@@ -130,6 +145,10 @@ extern Scene3D scene3DList[SCENE3D_COUNT];
 
 extern ScanEdge scanEdgeBuffer[SCREEN_YSIZE * 2];
 
+#if !RETRO_USE_ORIGINAL_CODE
+extern Scene3DStats scene3DStats[SCENE3D_COUNT];
+#endif
+
 void ProcessScanEdge(int32 x1, int32 y1, int32 x2, int32 y2);
 void ProcessScanEdgeClr(uint32 c1, uint32 c2, int32 x1, int32 y1, int32 x2, int32 y2);
 
@@ -216,6 +235,8 @@ inline void SetSpecularIntensity(uint16 sceneID, uint8 x, uint8 y, uint8 z)
 void AddModelToScene(uint16 modelFrames, uint16 sceneIndex, uint8 drawMode, Matrix *matWorld, Matrix *matView, color color);
 void AddMeshFrameToScene(uint16 modelFrames, uint16 sceneIndex, Animator *animator, uint8 drawMode, Matrix *matWorld, Matrix *matView, color color);
 void Sort3DDrawList(Scene3D *scn, int32 first, int32 last);
+// sorts a face buffer by depth (furthest first), faces with the same depth keep their order
+void SortFaceBuffer(Scene3DFace *faces, int32 count);
 void Draw3DScene(uint16 sceneID);
 
 inline void Clear3DScenes()
@@ -965,6 +965,10 @@ uint16 RSDK::LoadSpriteSheet(const char *filename, uint8 scope)
         image.pixels = surface->pixels;
         image.Load(NULL, false);
 
+#if !RETRO_USE_ORIGINAL_CODE
+        BuildSurfaceSpans(surface);
+#endif
+
 #if RETRO_USE_ORIGINAL_CODE
         image.palette = NULL;
         image.decoder = NULL;
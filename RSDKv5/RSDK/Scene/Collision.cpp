@@ -273,6 +273,123 @@ bool32 RSDK::CheckObjectCollisionTouch(Entity *thisEntity, Hitbox *thisHitbox, E
     return collided;
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+// returns a bit for each of the 8 positions that's strictly between the min & max bounds
+static inline uint32 CheckTouchBlock(const int32 *x, const int32 *y, int32 minX, int32 maxX, int32 minY, int32 maxY)
+{
+    uint32 mask = 0;
+
+#if RETRO_USE_SSE2
+    const __m128i lowX  = _mm_set1_epi32(minX);
+    const __m128i highX = _mm_set1_epi32(maxX);
+    const __m128i lowY  = _mm_set1_epi32(minY);
+    const __m128i highY = _mm_set1_epi32(maxY);
+
+    for (int32 i = 0; i < 8; i += 4) {
+        __m128i posX = _mm_loadu_si128((const __m128i *)&x[i]);
+        __m128i posY = _mm_loadu_si128((const __m128i *)&y[i]);
+
+        __m128i insideX = _mm_and_si128(_mm_cmpgt_epi32(posX, lowX), _mm_cmplt_epi32(posX, highX));
+        __m128i insideY = _mm_and_si128(_mm_cmpgt_epi32(posY, lowY), _mm_cmplt_epi32(posY, highY));
+        mask |= (uint32)_mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(insideX, insideY))) << i;
+    }
+#elif RETRO_USE_NEON
+    const int32x4_t lowX     = vdupq_n_s32(minX);
+    const int32x4_t highX    = vdupq_n_s32(maxX);
+    const int32x4_t lowY     = vdupq_n_s32(minY);
+    const int32x4_t highY    = vdupq_n_s32(maxY);
+    const uint32 laneBits[4] = { 1, 2, 4, 8 };
+    const uint32x4_t lanes   = vld1q_u32(laneBits);
+
+    for (int32 i = 0; i < 8; i += 4) {
+        int32x4_t posX = vld1q_s32(&x[i]);
+        int32x4_t posY = vld1q_s32(&y[i]);
+
+        uint32x4_t insideX = vandq_u32(vcgtq_s32(posX, lowX), vcltq_s32(posX, highX));
+        uint32x4_t insideY = vandq_u32(vcgtq_s32(posY, lowY), vcltq_s32(posY, highY));
+        mask |= vaddvq_u32(vandq_u32(vandq_u32(insideX, insideY), lanes)) << i;
+    }
+#else
+    for (int32 i = 0; i < 8; ++i) {
+        if (x[i] > minX && x[i] < maxX && y[i] > minY && y[i] < maxY)
+            mask |= 1 << i;
+    }
+#endif
+
+    return mask;
+}
+
+int32 RSDK::CheckObjectCollisionTouchList(Entity *thisEntity, Hitbox *thisHitbox, const uint16 *slots, int32 slotCount, Hitbox *otherHitbox,
+                                          uint16 *touches)
+{
+    if (!thisEntity || !thisHitbox || !otherHitbox || !slots || !touches)
+        return 0;
+
+    // same flips as CheckObjectCollisionTouch (both hitboxes use thisEntity's direction), but the hitboxes themselves are left alone
+    int32 thisLeft    = (thisEntity->direction & FLIP_X) == FLIP_X ? -thisHitbox->right : thisHitbox->left;
+    int32 thisRight   = (thisEntity->direction & FLIP_X) == FLIP_X ? -thisHitbox->left : thisHitbox->right;
+    int32 thisTop     = (thisEntity->direction & FLIP_Y) == FLIP_Y ? -thisHitbox->bottom : thisHitbox->top;
+    int32 thisBottom  = (thisEntity->direction & FLIP_Y) == FLIP_Y ? -thisHitbox->top : thisHitbox->bottom;
+    int32 otherLeft   = (thisEntity->direction & FLIP_X) == FLIP_X ? -otherHitbox->right : otherHitbox->left;
+    int32 otherRight  = (thisEntity->direction & FLIP_X) == FLIP_X ? -otherHitbox->left : otherHitbox->right;
+    int32 otherTop    = (thisEntity->direction & FLIP_Y) == FLIP_Y ? -otherHitbox->bottom : otherHitbox->top;
+    int32 otherBottom = (thisEntity->direction & FLIP_Y) == FLIP_Y ? -otherHitbox->top : otherHitbox->bottom;
+
+    int32 thisIX = FROM_FIXED(thisEntity->position.x);
+    int32 thisIY = FROM_FIXED(thisEntity->position.y);
+
+    // thisIX + thisLeft < otherIX + otherRight is otherIX > thisIX + thisLeft - otherRight, so each side becomes one bound on the other position
+    int32 minX = thisIX + thisLeft - otherRight;
+    int32 maxX = thisIX + thisRight - otherLeft;
+    int32 minY = thisIY + thisTop - otherBottom;
+    int32 maxY = thisIY + thisBottom - otherTop;
+
+    int32 thisHitboxID = showHitboxes ? AddDebugHitbox(H_TYPE_TOUCH, thisEntity->direction, thisEntity, thisHitbox) : -1;
+
+    int32 touchCount = 0;
+    for (int32 s = 0; s < slotCount; s += 8) {
+        int32 blockSize = MIN(slotCount - s, 8);
+
+        // unused lanes sit on the min bounds, which never count as inside
+        int32 x[8];
+        int32 y[8];
+        for (int32 i = 0; i < 8; ++i) {
+            if (i < blockSize && slots[s + i] < ENTITY_COUNT) {
+                x[i] = FROM_FIXED(objectEntityList[slots[s + i]].position.x);
+                y[i] = FROM_FIXED(objectEntityList[slots[s + i]].position.y);
+            }
+            else {
+                x[i] = minX;
+                y[i] = minY;
+            }
+        }
+
+        uint32 mask = CheckTouchBlock(x, y, minX, maxX, minY, maxY);
+
+        if (showHitboxes) {
+            for (int32 i = 0; i < blockSize; ++i) {
+                if (slots[s + i] >= ENTITY_COUNT)
+                    continue;
+
+                Entity *otherEntity = &objectEntityList[slots[s + i]];
+                int32 otherHitboxID = AddDebugHitbox(H_TYPE_TOUCH, otherEntity->direction, otherEntity, otherHitbox);
+
+                if ((mask >> i) & 1) {
+                    if (thisHitboxID >= 0)
+                        debugHitboxList[thisHitboxID].collision |= 1;
+                    if (otherHitboxID >= 0)
+                        debugHitboxList[otherHitboxID].collision |= 1;
+                }
+            }
+        }
+
+        for (uint32 bits = mask; bits; bits &= bits - 1) touches[touchCount++] = slots[s + CountTrailingZeros(bits)];
+    }
+
+    return touchCount;
+}
+#endif
+
 uint8 RSDK::CheckObjectCollisionBox(Entity *thisEntity, Hitbox *thisHitbox, Entity *otherEntity, Hitbox *otherHitbox, bool32 setValues)
 {
     if (!thisEntity || !otherEntity || !thisHitbox || !otherHitbox)
@@ -97,6 +97,12 @@ inline void GetCollisionInfo(CollisionMask **masks, TileInfo **tiles)
 #endif
 
 bool32 CheckObjectCollisionTouch(Entity *thisEntity, Hitbox *thisHitbox, Entity *otherEntity, Hitbox *otherHitbox);
+#if !RETRO_USE_ORIGINAL_CODE
+// CheckObjectCollisionTouch against a list of entity slots (such as a typeGroup's entries) that all use otherHitbox.
+// the slots that touched get written to touches (which needs room for slotCount entries) & how many there were is returned
+int32 CheckObjectCollisionTouchList(Entity *thisEntity, Hitbox *thisHitbox, const uint16 *slots, int32 slotCount, Hitbox *otherHitbox,
+                                    uint16 *touches);
+#endif
 inline bool32 CheckObjectCollisionCircle(Entity *thisEntity, int32 thisRadius, Entity *otherEntity, int32 otherRadius)
 {
     int32 x = FROM_FIXED(thisEntity->position.x - otherEntity->position.x);
@@ -20,7 +20,13 @@ int32 RSDK::editableVarCount = 0;
 
 TypeGroupList RSDK::typeGroups[TYPEGROUP_COUNT];
 
-bool32 RSDK::validDraw = false;
+#if !RETRO_USE_ORIGINAL_CODE
+EntityClassIndex RSDK::entityClassIndex;
+EntityGrid RSDK::entityGrid;
+ClassHashTable RSDK::classHashTable = { {}, true };
+#endif
+
+RETRO_THREAD_LOCAL bool32 RSDK::validDraw = false;
 
 ForeachStackInfo RSDK::foreachStackList[FOREACH_STACK_COUNT];
 ForeachStackInfo *RSDK::foreachStackPtr = NULL;
@@ -88,13 +94,35 @@ void RSDK::RegisterObject(Object **staticVars, const char *name, uint32 entityCl
 #endif
 
 #if !RETRO_USE_ORIGINAL_CODE
-        classInfo->name = name;
+        classInfo->name               = name;
+        classInfo->parallelUpdate     = NULL;
+        classInfo->parallelLateUpdate = NULL;
+
+        InvalidateClassHashTable();
 #endif
 
         ++objectClassCount;
     }
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+void RSDK::SetClassParallelUpdate(const char *name, void (*update)(void *entity), void (*lateUpdate)(void *entity))
+{
+    RETRO_HASH_MD5(hash);
+    GEN_HASH_MD5(name, hash);
+
+    for (int32 o = 0; o < objectClassCount; ++o) {
+        if (HASH_MATCH_MD5(hash, objectClassList[o].hash)) {
+            objectClassList[o].parallelUpdate     = update;
+            objectClassList[o].parallelLateUpdate = lateUpdate;
+            return;
+        }
+    }
+
+    PrintLog(PRINT_NORMAL, "Can't set the parallel update for unregistered class: %s", name);
+}
+#endif
+
 #if RETRO_REV02 || RETRO_USE_MOD_LOADER
 void RSDK::RegisterStaticVariables(void **staticVars, const char *name, uint32 classSize)
 {
@@ -306,6 +334,248 @@ void RSDK::LoadStaticVariables(uint8 *classPtr, uint32 *hash, int32 readOffset)
     }
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+// once most slots are set, hopping between bits costs more than just walking every slot (which is what dense does)
+#define ENTITYSLOT_DENSE_COUNT (ENTITY_COUNT * 3 / 4)
+
+static inline bool32 IsDenseBitmap(const uint32 *bitmap, uint32 invert)
+{
+    int32 count = 0;
+    for (int32 w = 0; w < ENTITYCLASS_INDEX_WORDS; ++w) count += CountSetBits(bitmap[w] ^ invert);
+
+    return count >= ENTITYSLOT_DENSE_COUNT;
+}
+
+// returns the first slot at or after slot with its bit set (or clear, if invert is 0xFFFFFFFF), or ENTITY_COUNT if there's none
+static inline int32 FindNextSlot(const uint32 *bitmap, int32 slot, uint32 invert, bool32 dense = false)
+{
+    if (dense || slot >= ENTITY_COUNT)
+        return slot < ENTITY_COUNT ? slot : ENTITY_COUNT;
+
+    int32 word  = slot >> 5;
+    uint32 bits = (bitmap[word] ^ invert) & (0xFFFFFFFF << (slot & 0x1F));
+    while (!bits) {
+        if (++word >= ENTITYCLASS_INDEX_WORDS)
+            return ENTITY_COUNT;
+
+        bits = bitmap[word] ^ invert;
+    }
+
+    int32 next = (word << 5) + CountTrailingZeros(bits);
+    return next < ENTITY_COUNT ? next : ENTITY_COUNT;
+}
+static inline int32 FindNextClassSlot(const uint32 *slots, int32 slot) { return FindNextSlot(slots, slot, 0); }
+// any slot that holds an entity (isn't filed under class 0)
+static inline int32 FindNextOccupiedSlot(int32 slot, bool32 dense)
+{
+    return FindNextSlot(entityClassIndex.slots[TYPE_DEFAULTOBJECT], slot, 0xFFFFFFFF, dense);
+}
+static inline bool32 IsDenselyOccupied() { return IsDenseBitmap(entityClassIndex.slots[TYPE_DEFAULTOBJECT], 0xFFFFFFFF); }
+
+// slots that were in range during this frame's update pass, the later passes only need to look at these
+static uint32 inRangeSlots[ENTITYCLASS_INDEX_WORDS];
+// slots that were in a draw list since the last update, the only ones that can still have onScreen set
+static uint32 onScreenSlots[ENTITYCLASS_INDEX_WORDS];
+
+static void GatherOnScreenSlots()
+{
+    memset(onScreenSlots, 0, sizeof(onScreenSlots));
+
+    for (int32 i = 0; i < DRAWGROUP_COUNT; ++i) {
+        for (int32 e = 0; e < drawGroups[i].entityCount; ++e) {
+            uint16 slot = drawGroups[i].entries[e];
+            if (slot < ENTITY_COUNT)
+                onScreenSlots[slot >> 5] |= 1u << (slot & 0x1F);
+        }
+    }
+}
+
+// in-range entities of parallel-safe classes, held back by the update/lateUpdate passes & run across the worker threads once the pass is done.
+// they're held back even with no worker threads (or no thread support at all), so the update order never depends on the thread setup
+static uint16 parallelSlots[ENTITY_COUNT];
+static uint16 parallelClassIDs[ENTITY_COUNT]; // the class each slot had when it was held back
+static int32 parallelSlotCount = 0;
+
+#define PARALLEL_SLOTS_PER_JOB (0x40)
+
+static inline bool32 DeferParallelUpdate(int32 slot, bool32 lateUpdate)
+{
+    ObjectClass *classInfo = &objectClassList[stageObjectIDs[objectEntityList[slot].classID]];
+    if (!(lateUpdate ? classInfo->parallelLateUpdate : classInfo->parallelUpdate))
+        return false;
+
+    parallelSlots[parallelSlotCount]      = slot;
+    parallelClassIDs[parallelSlotCount++] = objectEntityList[slot].classID;
+    return true;
+}
+
+static void ParallelUpdateJob(void *data, int32 jobID)
+{
+    bool32 lateUpdate = VOID_TO_INT(data);
+
+    int32 end = MIN((jobID + 1) * PARALLEL_SLOTS_PER_JOB, parallelSlotCount);
+    for (int32 i = jobID * PARALLEL_SLOTS_PER_JOB; i < end; ++i) {
+        uint16 slot            = parallelSlots[i];
+        Entity *entity         = &objectEntityList[slot];
+        ObjectClass *classInfo = &objectClassList[stageObjectIDs[entity->classID]];
+
+        if (lateUpdate) {
+            classInfo->parallelLateUpdate(entity);
+
+            // same as the lateUpdate pass does for everything else, it only touches this slot
+            entity->onScreen = 0;
+        }
+        else {
+            classInfo->parallelUpdate(entity);
+        }
+    }
+}
+
+// the deferred entities go into the draw lists in slot order, merged in with what the pass already added so draw order doesn't depend on threads
+static void MergeParallelDrawGroups()
+{
+    for (int32 g = 0; g < DRAWGROUP_COUNT; ++g) {
+        DrawList *list = &drawGroups[g];
+
+        int32 added = 0;
+        for (int32 i = 0; i < parallelSlotCount; ++i) {
+            if (objectEntityList[parallelSlots[i]].drawGroup == g)
+                ++added;
+        }
+
+        if (!added)
+            continue;
+
+        int32 src = list->entityCount - 1;
+        int32 dst = list->entityCount + added - 1;
+        for (int32 i = parallelSlotCount - 1; i >= 0; --i) {
+            uint16 slot = parallelSlots[i];
+            if (objectEntityList[slot].drawGroup != g)
+                continue;
+
+            while (src >= 0 && list->entries[src] > slot) list->entries[dst--] = list->entries[src--];
+            list->entries[dst--] = slot;
+        }
+
+        list->entityCount += added;
+    }
+}
+
+static void RunParallelUpdates(bool32 lateUpdate)
+{
+    // entities that ran later in the pass can destroy or reset a held back slot, those are dropped, the same as a slot that gets
+    // replaced after the regular pass has already been over it
+    int32 count = 0;
+    for (int32 i = 0; i < parallelSlotCount; ++i) {
+        uint16 slot            = parallelSlots[i];
+        uint16 classID         = objectEntityList[slot].classID;
+        ObjectClass *classInfo = &objectClassList[stageObjectIDs[classID]];
+
+        if (classID == parallelClassIDs[i] && (lateUpdate ? classInfo->parallelLateUpdate : classInfo->parallelUpdate)) {
+            parallelSlots[count]      = slot;
+            parallelClassIDs[count++] = classID;
+        }
+    }
+    parallelSlotCount = count;
+
+    if (!parallelSlotCount)
+        return;
+
+    int32 jobCount = (parallelSlotCount + PARALLEL_SLOTS_PER_JOB - 1) / PARALLEL_SLOTS_PER_JOB;
+#if RETRO_USE_THREADS
+    RunWorkerJobs(ParallelUpdateJob, INT_TO_VOID(lateUpdate), jobCount);
+#else
+    for (int32 j = 0; j < jobCount; ++j) ParallelUpdateJob(INT_TO_VOID(lateUpdate), j);
+#endif
+    if (!lateUpdate)
+        MergeParallelDrawGroups();
+
+    parallelSlotCount = 0;
+}
+
+void RSDK::UpdateEntityClassIndex(uint16 slot)
+{
+    if (objectEntityList[slot].classID && objectEntityList[slot].inRange) {
+        // arrived already in range (copied from an in-range entity, or set by its create callback) behind the update pass,
+        // a full scan would still give it its typeGroup & lateUpdate passes. the passes recheck inRange, so a stale bit is harmless
+        inRangeSlots[slot >> 5] |= 1u << (slot & 0x1F);
+    }
+
+    uint16 prevClassID = entityClassIndex.classIDs[slot];
+    uint16 classID     = objectEntityList[slot].classID;
+    if (prevClassID == classID)
+        return;
+
+    uint32 bit = 1u << (slot & 0x1F);
+    if (prevClassID < TYPE_COUNT)
+        entityClassIndex.slots[prevClassID][slot >> 5] &= ~bit;
+    if (classID < TYPE_COUNT)
+        entityClassIndex.slots[classID][slot >> 5] |= bit;
+
+    entityClassIndex.classIDs[slot] = classID;
+}
+
+void RSDK::RebuildEntityClassIndex()
+{
+    memset(entityClassIndex.slots, 0, sizeof(entityClassIndex.slots));
+    memset(inRangeSlots, 0, sizeof(inRangeSlots));
+
+    for (int32 e = 0; e < ENTITY_COUNT; ++e) {
+        uint16 classID               = objectEntityList[e].classID;
+        entityClassIndex.classIDs[e] = classID;
+
+        if (classID < TYPE_COUNT)
+            entityClassIndex.slots[classID][e >> 5] |= 1u << (e & 0x1F);
+
+        // the entities can come from a scene snapshot, so the later passes need to know which ones were already in range
+        if (classID && objectEntityList[e].inRange)
+            inRangeSlots[e >> 5] |= 1u << (e & 0x1F);
+    }
+}
+
+void RSDK::SyncEntityClassIndex()
+{
+    // slots filed as empty are the only ones the update passes never look at
+    const uint32 *blankSlots = entityClassIndex.slots[TYPE_DEFAULTOBJECT];
+    for (int32 e = FindNextSlot(blankSlots, 0, 0); e < ENTITY_COUNT; e = FindNextSlot(blankSlots, e + 1, 0)) {
+        if (objectEntityList[e].classID)
+            UpdateEntityClassIndex(e);
+    }
+}
+
+// the update passes read every occupied slot's classID anyway, so they refile the ones that changed behind the engine's back
+static inline void CheckEntityClassIndex(int32 slot)
+{
+    if (objectEntityList[slot].classID != entityClassIndex.classIDs[slot])
+        UpdateEntityClassIndex(slot);
+}
+
+bool32 RSDK::ValidateEntityClassIndex()
+{
+    for (int32 e = 0; e < ENTITY_COUNT; ++e) {
+        uint16 classID = objectEntityList[e].classID;
+
+        // every slot has to be set in exactly one bitmap, the one for the class it's filed under
+        uint16 filedClassID = entityClassIndex.classIDs[e];
+        for (int32 c = 0; c < TYPE_COUNT; ++c) {
+            bool32 isSet = (entityClassIndex.slots[c][e >> 5] >> (e & 0x1F)) & 1;
+            if (isSet != (c == filedClassID)) {
+                PrintLog(PRINT_NORMAL, "Entity class index mismatch: slot %d is %s in the bitmap for class %d (filed under %d)", e,
+                         isSet ? "set" : "not set", c, filedClassID);
+                return false;
+            }
+        }
+
+        if (classID != filedClassID) {
+            PrintLog(PRINT_NORMAL, "Entity class index mismatch: slot %d has classID %d but is filed under %d", e, classID, filedClassID);
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
 void RSDK::InitObjects()
 {
     sceneInfo.entitySlot = 0;
@@ -344,6 +614,17 @@ void RSDK::InitObjects()
 }
 void RSDK::ProcessObjects()
 {
+#if !RETRO_USE_ORIGINAL_CODE
+#if RETRO_VALIDATE_ENTITY_INDEX
+    // before the sync, otherwise any classID change that skipped UpdateEntityClassIndex would already be fixed up
+    ValidateEntityClassIndex();
+#endif
+    SyncEntityClassIndex();
+#endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+    GatherOnScreenSlots();
+#endif
     for (int32 i = 0; i < DRAWGROUP_COUNT; ++i) drawGroups[i].entityCount = 0;
 
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
@@ -377,9 +658,19 @@ void RSDK::ProcessObjects()
         }
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    memset(inRangeSlots, 0, sizeof(inRangeSlots));
+    bool32 dense = IsDenselyOccupied();
+    for (int32 e = FindNextOccupiedSlot(0, dense); e < ENTITY_COUNT; e = FindNextOccupiedSlot(e + 1, dense)) {
+        sceneInfo.entitySlot = e;
+#else
     sceneInfo.entitySlot = 0;
     for (int32 e = 0; e < ENTITY_COUNT; ++e) {
+#endif
         sceneInfo.entity = &objectEntityList[e];
+#if !RETRO_USE_ORIGINAL_CODE
+        CheckEntityClassIndex(e);
+#endif
         if (sceneInfo.entity->classID) {
             switch (sceneInfo.entity->active) {
                 default:
@@ -448,6 +739,13 @@ void RSDK::ProcessObjects()
             }
 
             if (sceneInfo.entity->inRange) {
+#if !RETRO_USE_ORIGINAL_CODE
+                inRangeSlots[e >> 5] |= 1u << (e & 0x1F);
+
+                if (DeferParallelUpdate(e, false))
+                    continue;
+#endif
+
                 if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update)
                     objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update();
 
@@ -462,14 +760,27 @@ void RSDK::ProcessObjects()
         sceneInfo.entitySlot++;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    RunParallelUpdates(false);
+#endif
+
 #if RETRO_USE_MOD_LOADER
     RunModCallbacks(MODCB_ONUPDATE, INT_TO_VOID(ENGINESTATE_REGULAR));
 #endif
 
     for (int32 i = 0; i < TYPEGROUP_COUNT; ++i) typeGroups[i].entryCount = 0;
+#if !RETRO_USE_ORIGINAL_CODE
+    InvalidateEntityGrid();
+#endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+    dense = IsDenseBitmap(inRangeSlots, 0);
+    for (int32 e = FindNextSlot(inRangeSlots, 0, 0, dense); e < ENTITY_COUNT; e = FindNextSlot(inRangeSlots, e + 1, 0, dense)) {
+        sceneInfo.entitySlot = e;
+#else
     sceneInfo.entitySlot = 0;
     for (int32 e = 0; e < ENTITY_COUNT; ++e) {
+#endif
         sceneInfo.entity = &objectEntityList[e];
 
         if (sceneInfo.entity->inRange && sceneInfo.entity->interaction) {
@@ -484,11 +795,24 @@ void RSDK::ProcessObjects()
         sceneInfo.entitySlot++;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    // both bitmaps are reread every step, entities created or copied in range ahead of this slot get their bit set by UpdateEntityClassIndex
+    dense = IsDenseBitmap(inRangeSlots, 0);
+    for (int32 e = MIN(FindNextSlot(inRangeSlots, 0, 0, dense), FindNextSlot(onScreenSlots, 0, 0)); e < ENTITY_COUNT;
+         e = MIN(FindNextSlot(inRangeSlots, e + 1, 0, dense), FindNextSlot(onScreenSlots, e + 1, 0))) {
+        sceneInfo.entitySlot = e;
+#else
     sceneInfo.entitySlot = 0;
     for (int32 e = 0; e < ENTITY_COUNT; ++e) {
+#endif
         sceneInfo.entity = &objectEntityList[e];
 
         if (sceneInfo.entity->inRange) {
+#if !RETRO_USE_ORIGINAL_CODE
+            if (DeferParallelUpdate(e, true))
+                continue;
+#endif
+
             if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate)
                 objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate();
         }
@@ -497,12 +821,27 @@ void RSDK::ProcessObjects()
         sceneInfo.entitySlot++;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    RunParallelUpdates(true);
+#endif
+
 #if RETRO_USE_MOD_LOADER
     RunModCallbacks(MODCB_ONLATEUPDATE, INT_TO_VOID(ENGINESTATE_REGULAR));
 #endif
 }
 void RSDK::ProcessPausedObjects()
 {
+#if !RETRO_USE_ORIGINAL_CODE
+#if RETRO_VALIDATE_ENTITY_INDEX
+    // before the sync, otherwise any classID change that skipped UpdateEntityClassIndex would already be fixed up
+    ValidateEntityClassIndex();
+#endif
+    SyncEntityClassIndex();
+#endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+    GatherOnScreenSlots();
+#endif
     for (int32 i = 0; i < DRAWGROUP_COUNT; ++i) drawGroups[i].entityCount = 0;
 
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
@@ -521,9 +860,18 @@ void RSDK::ProcessPausedObjects()
     RunModCallbacks(MODCB_ONSTATICUPDATE, INT_TO_VOID(ENGINESTATE_PAUSED));
 #endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+    bool32 dense = IsDenselyOccupied();
+    for (int32 e = FindNextOccupiedSlot(0, dense); e < ENTITY_COUNT; e = FindNextOccupiedSlot(e + 1, dense)) {
+        sceneInfo.entitySlot = e;
+#else
     sceneInfo.entitySlot = 0;
     for (int32 e = 0; e < ENTITY_COUNT; ++e) {
+#endif
         sceneInfo.entity = &objectEntityList[e];
+#if !RETRO_USE_ORIGINAL_CODE
+        CheckEntityClassIndex(e);
+#endif
 
         if (sceneInfo.entity->classID) {
             if (sceneInfo.entity->active == ACTIVE_ALWAYS || sceneInfo.entity->active == ACTIVE_PAUSED) {
@@ -545,8 +893,16 @@ void RSDK::ProcessPausedObjects()
     RunModCallbacks(MODCB_ONUPDATE, INT_TO_VOID(ENGINESTATE_PAUSED));
 #endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+    // entities created during this pass still get their late update, so the occupancy has to be checked as we go
+    dense = IsDenselyOccupied();
+    for (int32 e = MIN(FindNextOccupiedSlot(0, dense), FindNextSlot(onScreenSlots, 0, 0)); e < ENTITY_COUNT;
+         e = MIN(FindNextOccupiedSlot(e + 1, dense), FindNextSlot(onScreenSlots, e + 1, 0))) {
+        sceneInfo.entitySlot = e;
+#else
     sceneInfo.entitySlot = 0;
     for (int32 e = 0; e < ENTITY_COUNT; ++e) {
+#endif
         sceneInfo.entity = &objectEntityList[e];
 
         if (sceneInfo.entity->active == ACTIVE_ALWAYS || sceneInfo.entity->active == ACTIVE_PAUSED) {
@@ -564,6 +920,17 @@ void RSDK::ProcessPausedObjects()
 }
 void RSDK::ProcessFrozenObjects()
 {
+#if !RETRO_USE_ORIGINAL_CODE
+#if RETRO_VALIDATE_ENTITY_INDEX
+    // before the sync, otherwise any classID change that skipped UpdateEntityClassIndex would already be fixed up
+    ValidateEntityClassIndex();
+#endif
+    SyncEntityClassIndex();
+#endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+    GatherOnScreenSlots();
+#endif
     for (int32 i = 0; i < DRAWGROUP_COUNT; ++i) drawGroups[i].entityCount = 0;
 
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
@@ -597,9 +964,19 @@ void RSDK::ProcessFrozenObjects()
         }
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    memset(inRangeSlots, 0, sizeof(inRangeSlots));
+    bool32 dense = IsDenselyOccupied();
+    for (int32 e = FindNextOccupiedSlot(0, dense); e < ENTITY_COUNT; e = FindNextOccupiedSlot(e + 1, dense)) {
+        sceneInfo.entitySlot = e;
+#else
     sceneInfo.entitySlot = 0;
     for (int32 e = 0; e < ENTITY_COUNT; ++e) {
+#endif
         sceneInfo.entity = &objectEntityList[e];
+#if !RETRO_USE_ORIGINAL_CODE
+        CheckEntityClassIndex(e);
+#endif
 
         if (sceneInfo.entity->classID) {
             switch (sceneInfo.entity->active) {
@@ -669,6 +1046,9 @@ void RSDK::ProcessFrozenObjects()
             }
 
             if (sceneInfo.entity->inRange) {
+#if !RETRO_USE_ORIGINAL_CODE
+                inRangeSlots[e >> 5] |= 1u << (e & 0x1F);
+#endif
                 if (sceneInfo.entity->active == ACTIVE_ALWAYS || sceneInfo.entity->active == ACTIVE_PAUSED) {
                     if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update)
                         objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update();
@@ -690,9 +1070,20 @@ void RSDK::ProcessFrozenObjects()
 #endif
 
     for (int32 i = 0; i < TYPEGROUP_COUNT; ++i) typeGroups[i].entryCount = 0;
+#if !RETRO_USE_ORIGINAL_CODE
+    InvalidateEntityGrid();
+#endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+    // both bitmaps are reread every step, entities created or copied in range ahead of this slot get their bit set by UpdateEntityClassIndex
+    dense = IsDenseBitmap(inRangeSlots, 0);
+    for (int32 e = MIN(FindNextSlot(inRangeSlots, 0, 0, dense), FindNextSlot(onScreenSlots, 0, 0)); e < ENTITY_COUNT;
+         e = MIN(FindNextSlot(inRangeSlots, e + 1, 0, dense), FindNextSlot(onScreenSlots, e + 1, 0))) {
+        sceneInfo.entitySlot = e;
+#else
     sceneInfo.entitySlot = 0;
     for (int32 e = 0; e < ENTITY_COUNT; ++e) {
+#endif
         sceneInfo.entity = &objectEntityList[e];
 
         if (sceneInfo.entity->inRange) {
@@ -719,288 +1110,446 @@ void RSDK::ProcessFrozenObjects()
     RunModCallbacks(MODCB_ONLATEUPDATE, INT_TO_VOID(ENGINESTATE_FROZEN));
 #endif
 }
-void RSDK::ProcessObjectDrawLists()
+#if RETRO_USE_THREADS
+// when screens are drawn in parallel (Video:parallelScreens), every game callback still runs on the main thread, only the layer rasterisation
+// is split up. the callbacks run draw group by draw group across the screens rather than screen by screen, so it isn't bit-exact with the
+// serial path for objects that share state between screens while drawing, which is why it's opt-in
+// each layer gets its own scanlines & active palette lines so they can all be prepared before any of them are drawn
+static ScanlineInfo layerScanlines[SCREEN_COUNT][LAYER_COUNT][SCREEN_XMAX];
+static uint8 layerLineBuffers[SCREEN_COUNT][LAYER_COUNT][SCREEN_YSIZE];
+static uint8 screenLineBuffers[SCREEN_COUNT][SCREEN_YSIZE];
+
+static uint16 screenLayerDrawList[SCREEN_COUNT][DRAWGROUP_COUNT][LAYER_COUNT];
+static int32 screenLayerCount[SCREEN_COUNT][DRAWGROUP_COUNT];
+
+// later screens' callbacks run before a screen's layers are drawn, so each screen's layers are drawn with the palette its own callbacks left
+static uint16 screenPalettes[SCREEN_COUNT][PALETTE_BANK_COUNT][PALETTE_BANK_SIZE];
+static uint16 (*screenLayerPalettes[SCREEN_COUNT])[PALETTE_BANK_SIZE];
+
+// entity draws in later groups would still see another screen's palette changes, so a frame where any draw callback changed the palette
+// makes the next ones draw screen by screen, until one goes by without a change. the frame that made the change is already drawn by then
+static uint16 drawPalette[PALETTE_BANK_COUNT][PALETTE_BANK_SIZE];
+static bool32 drawPaletteChanged = false;
+static bool32 parallelScreenDraws = true;
+
+static void CheckDrawPalette()
 {
-    if (sceneInfo.state != ENGINESTATE_LOAD && sceneInfo.state != (ENGINESTATE_LOAD | ENGINESTATE_STEPOVER)) {
-        for (int32 s = 0; s < videoSettings.screenCount; ++s) {
-            currentScreen             = &screens[s];
-            sceneInfo.currentScreenID = s;
+    if (memcmp(drawPalette, fullPalette, sizeof(fullPalette))) {
+        memcpy(drawPalette, fullPalette, sizeof(fullPalette));
+        drawPaletteChanged = true;
+    }
+}
+#endif
 
-            for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) drawGroups[l].layerCount = 0;
+static void BuildLayerDrawLists(int32 screenID, uint16 (*layerDrawList)[LAYER_COUNT], int32 *layerCount)
+{
+    for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) layerCount[l] = 0;
 
-            for (int32 t = 0; t < LAYER_COUNT; ++t) {
-                uint8 drawGroup = tileLayers[t].drawGroup[s];
+    for (int32 t = 0; t < LAYER_COUNT; ++t) {
+        uint8 drawGroup = tileLayers[t].drawGroup[screenID];
 
-                if (drawGroup < DRAWGROUP_COUNT)
-                    drawGroups[drawGroup].layerDrawList[drawGroups[drawGroup].layerCount++] = t;
-            }
+        if (drawGroup < DRAWGROUP_COUNT)
+            layerDrawList[drawGroup][layerCount[drawGroup]++] = t;
+    }
+}
 
-            sceneInfo.currentDrawGroup = 0;
-            for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) {
-                if (engine.drawGroupVisible[l]) {
-                    DrawList *list = &drawGroups[l];
-
-                    if (list->hookCB)
-                        list->hookCB();
-
-                    if (list->sorted) {
-                        for (int32 e = 0; e < list->entityCount; ++e) {
-                            for (int32 i = list->entityCount - 1; i > e; --i) {
-                                int32 slot1 = list->entries[i - 1];
-                                int32 slot2 = list->entries[i];
-                                if (objectEntityList[slot2].zdepth > objectEntityList[slot1].zdepth) {
-                                    list->entries[i - 1] = slot2;
-                                    list->entries[i]     = slot1;
-                                }
-                            }
-                        }
-                    }
+static void DrawGroupEntities(int32 screenID, int32 drawGroup)
+{
+    DrawList *list = &drawGroups[drawGroup];
+
+    sceneInfo.currentScreenID  = screenID;
+    sceneInfo.currentDrawGroup = drawGroup;
 
-                    for (int32 i = 0; i < list->entityCount; ++i) {
-                        sceneInfo.entitySlot = list->entries[i];
-                        validDraw            = false;
-                        sceneInfo.entity     = &objectEntityList[list->entries[i]];
-                        if (sceneInfo.entity->visible) {
-                            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].draw)
-                                objectClassList[stageObjectIDs[sceneInfo.entity->classID]].draw();
+    if (list->hookCB)
+        list->hookCB();
+
+    if (list->sorted)
+        SortDrawList(list);
+
+    for (int32 i = 0; i < list->entityCount; ++i) {
+        sceneInfo.entitySlot = list->entries[i];
+        validDraw            = false;
+        sceneInfo.entity     = &objectEntityList[list->entries[i]];
+        if (sceneInfo.entity->visible) {
+            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].draw)
+                objectClassList[stageObjectIDs[sceneInfo.entity->classID]].draw();
 
 #if RETRO_VER_EGS || RETRO_USE_DUMMY_ACHIEVEMENTS
-                            if (i == list->entityCount - 1)
-                                SKU::DrawAchievements();
+            if (i == list->entityCount - 1)
+                SKU::DrawAchievements();
 #endif
 
-                            sceneInfo.entity->onScreen |= validDraw << sceneInfo.currentScreenID;
-                        }
-                    }
-
-                    for (int32 i = 0; i < list->layerCount; ++i) {
-                        TileLayer *layer = &tileLayers[list->layerDrawList[i]];
+            sceneInfo.entity->onScreen |= validDraw << screenID;
+        }
+    }
+}
 
+static void ProcessLayerScanlines(TileLayer *layer)
+{
 #if RETRO_USE_MOD_LOADER
-                        RunModCallbacks(MODCB_ONSCANLINECB, (void *)layer->scanlineCallback);
-#endif
-                        if (layer->scanlineCallback)
-                            layer->scanlineCallback(scanlines);
-                        else
-                            ProcessParallax(layer);
-
-                        switch (layer->type) {
-                            case LAYER_HSCROLL: DrawLayerHScroll(layer); break;
-                            case LAYER_VSCROLL: DrawLayerVScroll(layer); break;
-                            case LAYER_ROTOZOOM: DrawLayerRotozoom(layer); break;
-                            case LAYER_BASIC: DrawLayerBasic(layer); break;
-                            default: break;
-                        }
-                    }
+    RunModCallbacks(MODCB_ONSCANLINECB, (void *)layer->scanlineCallback);
+#endif
+    if (layer->scanlineCallback)
+        layer->scanlineCallback(scanlines);
+    else
+        ProcessParallax(layer);
+}
 
+static void FinishDrawGroup(int32 drawGroup)
+{
 #if RETRO_USE_MOD_LOADER
-                    RunModCallbacks(MODCB_ONDRAW, INT_TO_VOID(l));
+    RunModCallbacks(MODCB_ONDRAW, INT_TO_VOID(drawGroup));
+#else
+    (void)drawGroup;
 #endif
 
-                    if (currentScreen->clipBound_X1 > 0)
-                        currentScreen->clipBound_X1 = 0;
+    if (currentScreen->clipBound_X1 > 0)
+        currentScreen->clipBound_X1 = 0;
 
-                    if (currentScreen->clipBound_Y1 > 0)
-                        currentScreen->clipBound_Y1 = 0;
+    if (currentScreen->clipBound_Y1 > 0)
+        currentScreen->clipBound_Y1 = 0;
 
-                    if (currentScreen->size.x >= 0) {
-                        if (currentScreen->clipBound_X2 < currentScreen->size.x)
-                            currentScreen->clipBound_X2 = currentScreen->size.x;
-                    }
-                    else {
-                        currentScreen->clipBound_X2 = 0;
-                    }
+    if (currentScreen->size.x >= 0) {
+        if (currentScreen->clipBound_X2 < currentScreen->size.x)
+            currentScreen->clipBound_X2 = currentScreen->size.x;
+    }
+    else {
+        currentScreen->clipBound_X2 = 0;
+    }
 
-                    if (currentScreen->size.y >= 0) {
-                        if (currentScreen->clipBound_Y2 < currentScreen->size.y)
-                            currentScreen->clipBound_Y2 = currentScreen->size.y;
-                    }
-                    else {
-                        currentScreen->clipBound_Y2 = 0;
-                    }
-                }
+    if (currentScreen->size.y >= 0) {
+        if (currentScreen->clipBound_Y2 < currentScreen->size.y)
+            currentScreen->clipBound_Y2 = currentScreen->size.y;
+    }
+    else {
+        currentScreen->clipBound_Y2 = 0;
+    }
+}
 
-                sceneInfo.currentDrawGroup++;
-            }
+static void DrawScreenOverlays(int32 screenID)
+{
+    currentScreen              = &screens[screenID];
+    sceneInfo.currentScreenID  = screenID;
+    sceneInfo.currentDrawGroup = DRAWGROUP_COUNT;
 
 #if !RETRO_USE_ORIGINAL_CODE
-            if (engine.showUpdateRanges) {
-                for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) {
-                    if (engine.drawGroupVisible[l]) {
-                        DrawList *list = &drawGroups[l];
-                        for (int32 i = 0; i < list->entityCount; ++i) {
-                            Entity *entity     = &objectEntityList[list->entries[i]];
-
-                            if (entity->visible || (engine.showUpdateRanges & 2)) {
-                                switch (entity->active) {
-                                    default:
-                                    case ACTIVE_DISABLED:
-                                    case ACTIVE_NEVER: break;
-
-                                    case ACTIVE_ALWAYS:
-                                    case ACTIVE_NORMAL: 
-                                    case ACTIVE_PAUSED:
-                                        DrawRectangle(entity->position.x, entity->position.y, TO_FIXED(1), TO_FIXED(1), 0x0000FF, 0xFF, INK_NONE,
-                                                      false);
-                                        break;
-
-                                    case ACTIVE_BOUNDS:
-                                        DrawLine(entity->position.x - entity->updateRange.x, entity->position.y - entity->updateRange.y,
-                                                 entity->position.x + entity->updateRange.x, entity->position.y - entity->updateRange.y, 0x0000FF,
-                                                 0xFF, INK_NONE, false);
-
-                                        DrawLine(entity->position.x - entity->updateRange.x, entity->position.y + entity->updateRange.y,
-                                                 entity->position.x + entity->updateRange.x, entity->position.y + entity->updateRange.y, 0x0000FF,
-                                                 0xFF, INK_NONE, false);
-
-                                        DrawLine(entity->position.x - entity->updateRange.x, entity->position.y - entity->updateRange.y,
-                                                 entity->position.x - entity->updateRange.x, entity->position.y + entity->updateRange.y, 0x0000FF,
-                                                 0xFF, INK_NONE, false);
-
-                                        DrawLine(entity->position.x + entity->updateRange.x, entity->position.y - entity->updateRange.y,
-                                                 entity->position.x + entity->updateRange.x, entity->position.y + entity->updateRange.y, 0x0000FF,
-                                                 0xFF, INK_NONE, false);
-                                        break;
-
-                                    case ACTIVE_XBOUNDS:
-                                        DrawLine(entity->position.x - entity->updateRange.x, TO_FIXED(currentScreen->position.y),
-                                                 entity->position.x - entity->updateRange.x,
-                                                 TO_FIXED(currentScreen->position.y + currentScreen->size.y), 0x0000FF, 0xFF, INK_NONE, false);
-
-                                        DrawLine(entity->position.x + entity->updateRange.x, TO_FIXED(currentScreen->position.y),
-                                                 entity->position.x + entity->updateRange.x,
-                                                 TO_FIXED(currentScreen->position.y + currentScreen->size.y), 0x0000FF, 0xFF, INK_NONE, false);
-                                        break;
-
-                                    case ACTIVE_YBOUNDS:
-                                        DrawLine(TO_FIXED(currentScreen->position.x), entity->position.y - entity->updateRange.y,
-                                                 TO_FIXED(currentScreen->position.x + currentScreen->size.x),
-                                                 entity->position.y - entity->updateRange.y, 0x0000FF, 0xFF, INK_NONE, false);
-
-                                        DrawLine(TO_FIXED(currentScreen->position.x), entity->position.y + entity->updateRange.y,
-                                                 TO_FIXED(currentScreen->position.x + currentScreen->size.x),
-                                                 entity->position.y + entity->updateRange.y, 0x0000FF, 0xFF, INK_NONE, false);
-                                        break;
-
-                                    case ACTIVE_RBOUNDS:
-                                        DrawCircleOutline(entity->position.x, entity->position.y, FROM_FIXED(entity->updateRange.x),
-                                                          FROM_FIXED(entity->updateRange.x) + 1, 0x0000FF, 0xFF, INK_NONE, false);
-                                        break;
-                                }
-                            }
+    if (engine.showUpdateRanges) {
+        for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) {
+            if (engine.drawGroupVisible[l]) {
+                DrawList *list = &drawGroups[l];
+                for (int32 i = 0; i < list->entityCount; ++i) {
+                    Entity *entity     = &objectEntityList[list->entries[i]];
+
+                    if (entity->visible || (engine.showUpdateRanges & 2)) {
+                        switch (entity->active) {
+                            default:
+                            case ACTIVE_DISABLED:
+                            case ACTIVE_NEVER: break;
+
+                            case ACTIVE_ALWAYS:
+                            case ACTIVE_NORMAL: 
+                            case ACTIVE_PAUSED:
+                                DrawRectangle(entity->position.x, entity->position.y, TO_FIXED(1), TO_FIXED(1), 0x0000FF, 0xFF, INK_NONE,
+                                              false);
+                                break;
+
+                            case ACTIVE_BOUNDS:
+                                DrawLine(entity->position.x - entity->updateRange.x, entity->position.y - entity->updateRange.y,
+                                         entity->position.x + entity->updateRange.x, entity->position.y - entity->updateRange.y, 0x0000FF,
+                                         0xFF, INK_NONE, false);
+
+                                DrawLine(entity->position.x - entity->updateRange.x, entity->position.y + entity->updateRange.y,
+                                         entity->position.x + entity->updateRange.x, entity->position.y + entity->updateRange.y, 0x0000FF,
+                                         0xFF, INK_NONE, false);
+
+                                DrawLine(entity->position.x - entity->updateRange.x, entity->position.y - entity->updateRange.y,
+                                         entity->position.x - entity->updateRange.x, entity->position.y + entity->updateRange.y, 0x0000FF,
+                                         0xFF, INK_NONE, false);
+
+                                DrawLine(entity->position.x + entity->updateRange.x, entity->position.y - entity->updateRange.y,
+                                         entity->position.x + entity->updateRange.x, entity->position.y + entity->updateRange.y, 0x0000FF,
+                                         0xFF, INK_NONE, false);
+                                break;
+
+                            case ACTIVE_XBOUNDS:
+                                DrawLine(entity->position.x - entity->updateRange.x, TO_FIXED(currentScreen->position.y),
+                                         entity->position.x - entity->updateRange.x,
+                                         TO_FIXED(currentScreen->position.y + currentScreen->size.y), 0x0000FF, 0xFF, INK_NONE, false);
+
+                                DrawLine(entity->position.x + entity->updateRange.x, TO_FIXED(currentScreen->position.y),
+                                         entity->position.x + entity->updateRange.x,
+                                         TO_FIXED(currentScreen->position.y + currentScreen->size.y), 0x0000FF, 0xFF, INK_NONE, false);
+                                break;
+
+                            case ACTIVE_YBOUNDS:
+                                DrawLine(TO_FIXED(currentScreen->position.x), entity->position.y - entity->updateRange.y,
+                                         TO_FIXED(currentScreen->position.x + currentScreen->size.x),
+                                         entity->position.y - entity->updateRange.y, 0x0000FF, 0xFF, INK_NONE, false);
+
+                                DrawLine(TO_FIXED(currentScreen->position.x), entity->position.y + entity->updateRange.y,
+                                         TO_FIXED(currentScreen->position.x + currentScreen->size.x),
+                                         entity->position.y + entity->updateRange.y, 0x0000FF, 0xFF, INK_NONE, false);
+                                break;
+
+                            case ACTIVE_RBOUNDS:
+                                DrawCircleOutline(entity->position.x, entity->position.y, FROM_FIXED(entity->updateRange.x),
+                                                  FROM_FIXED(entity->updateRange.x) + 1, 0x0000FF, 0xFF, INK_NONE, false);
+                                break;
                         }
                     }
                 }
             }
+        }
+    }
 
-            if (engine.showEntityInfo) {
-                for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) {
-                    if (engine.drawGroupVisible[l]) {
-                        DrawList *list = &drawGroups[l];
-                        for (int32 i = 0; i < list->entityCount; ++i) {
-                            Entity *entity = &objectEntityList[list->entries[i]];
+    if (engine.showEntityInfo) {
+        for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) {
+            if (engine.drawGroupVisible[l]) {
+                DrawList *list = &drawGroups[l];
+                for (int32 i = 0; i < list->entityCount; ++i) {
+                    Entity *entity = &objectEntityList[list->entries[i]];
 
-                            if (entity->visible || (engine.showEntityInfo & 2)) {
-                                char buffer[0x100];
-                                sprintf_s(buffer, sizeof(buffer), "%s\nx: %g\ny: %g", objectClassList[stageObjectIDs[entity->classID]].name,
-                                          entity->position.x / 65536.0f, entity->position.y / 65536.0f);
+                    if (entity->visible || (engine.showEntityInfo & 2)) {
+                        char buffer[0x100];
+                        sprintf_s(buffer, sizeof(buffer), "%s\nx: %g\ny: %g", objectClassList[stageObjectIDs[entity->classID]].name,
+                                  entity->position.x / 65536.0f, entity->position.y / 65536.0f);
 
-                                DrawDevString(buffer, FROM_FIXED(entity->position.x) - currentScreen->position.x,
-                                              FROM_FIXED(entity->position.y) - currentScreen->position.y, ALIGN_LEFT, 0xF0F0F0);
-                            }
-                        }
+                        DrawDevString(buffer, FROM_FIXED(entity->position.x) - currentScreen->position.x,
+                                      FROM_FIXED(entity->position.y) - currentScreen->position.y, ALIGN_LEFT, 0xF0F0F0);
                     }
                 }
             }
+        }
+    }
 
-            if (showHitboxes) {
-                for (int32 i = 0; i < debugHitboxCount; ++i) {
-                    DebugHitboxInfo *info = &debugHitboxList[i];
-                    int32 x               = info->pos.x + TO_FIXED(info->hitbox.left);
-                    int32 y               = info->pos.y + TO_FIXED(info->hitbox.top);
-                    int32 w               = abs((info->pos.x + TO_FIXED(info->hitbox.right)) - x);
-                    int32 h               = abs((info->pos.y + TO_FIXED(info->hitbox.bottom)) - y);
+    if (showHitboxes) {
+        for (int32 i = 0; i < debugHitboxCount; ++i) {
+            DebugHitboxInfo *info = &debugHitboxList[i];
+            int32 x               = info->pos.x + TO_FIXED(info->hitbox.left);
+            int32 y               = info->pos.y + TO_FIXED(info->hitbox.top);
+            int32 w               = abs((info->pos.x + TO_FIXED(info->hitbox.right)) - x);
+            int32 h               = abs((info->pos.y + TO_FIXED(info->hitbox.bottom)) - y);
 
-                    switch (info->type) {
-                        case H_TYPE_TOUCH: DrawRectangle(x, y, w, h, info->collision ? 0x808000 : 0xFF0000, 0x60, INK_ALPHA, false); break;
+            switch (info->type) {
+                case H_TYPE_TOUCH: DrawRectangle(x, y, w, h, info->collision ? 0x808000 : 0xFF0000, 0x60, INK_ALPHA, false); break;
 
-                        case H_TYPE_CIRCLE:
-                            DrawCircle(info->pos.x, info->pos.y, info->hitbox.left, info->collision ? 0x808000 : 0xFF0000, 0x60, INK_ALPHA, false);
-                            break;
+                case H_TYPE_CIRCLE:
+                    DrawCircle(info->pos.x, info->pos.y, info->hitbox.left, info->collision ? 0x808000 : 0xFF0000, 0x60, INK_ALPHA, false);
+                    break;
 
-                        case H_TYPE_BOX:
-                            DrawRectangle(x, y, w, h, 0x0000FF, 0x60, INK_ALPHA, false);
+                case H_TYPE_BOX:
+                    DrawRectangle(x, y, w, h, 0x0000FF, 0x60, INK_ALPHA, false);
 
-                            if (info->collision & 1) // top
-                                DrawRectangle(x, y, w, TO_FIXED(1), 0xFFFF00, 0xC0, INK_ALPHA, false);
+                    if (info->collision & 1) // top
+                        DrawRectangle(x, y, w, TO_FIXED(1), 0xFFFF00, 0xC0, INK_ALPHA, false);
 
-                            if (info->collision & 8) // bottom
-                                DrawRectangle(x, y + h, w, TO_FIXED(1), 0xFFFF00, 0xC0, INK_ALPHA, false);
+                    if (info->collision & 8) // bottom
+                        DrawRectangle(x, y + h, w, TO_FIXED(1), 0xFFFF00, 0xC0, INK_ALPHA, false);
 
-                            if (info->collision & 2) { // left
-                                int32 sy = y;
-                                int32 sh = h;
+                    if (info->collision & 2) { // left
+                        int32 sy = y;
+                        int32 sh = h;
 
-                                if (info->collision & 1) {
-                                    sy += TO_FIXED(1);
-                                    sh -= TO_FIXED(1);
-                                }
+                        if (info->collision & 1) {
+                            sy += TO_FIXED(1);
+                            sh -= TO_FIXED(1);
+                        }
 
-                                if (info->collision & 8)
-                                    sh -= TO_FIXED(1);
+                        if (info->collision & 8)
+                            sh -= TO_FIXED(1);
 
-                                DrawRectangle(x, sy, TO_FIXED(1), sh, 0xFFFF00, 0xC0, INK_ALPHA, false);
-                            }
+                        DrawRectangle(x, sy, TO_FIXED(1), sh, 0xFFFF00, 0xC0, INK_ALPHA, false);
+                    }
 
-                            if (info->collision & 4) { // right
-                                int32 sy = y;
-                                int32 sh = h;
+                    if (info->collision & 4) { // right
+                        int32 sy = y;
+                        int32 sh = h;
 
-                                if (info->collision & 1) {
-                                    sy += TO_FIXED(1);
-                                    sh -= TO_FIXED(1);
-                                }
+                        if (info->collision & 1) {
+                            sy += TO_FIXED(1);
+                            sh -= TO_FIXED(1);
+                        }
 
-                                if (info->collision & 8)
-                                    sh -= TO_FIXED(1);
+                        if (info->collision & 8)
+                            sh -= TO_FIXED(1);
 
-                                DrawRectangle(x + w, sy, TO_FIXED(1), sh, 0xFFFF00, 0xC0, INK_ALPHA, false);
-                            }
-                            break;
+                        DrawRectangle(x + w, sy, TO_FIXED(1), sh, 0xFFFF00, 0xC0, INK_ALPHA, false);
+                    }
+                    break;
 
-                        case H_TYPE_PLAT:
-                            DrawRectangle(x, y, w, h, 0x00FF00, 0x60, INK_ALPHA, false);
+                case H_TYPE_PLAT:
+                    DrawRectangle(x, y, w, h, 0x00FF00, 0x60, INK_ALPHA, false);
 
-                            if (info->collision & 1) // top
-                                DrawRectangle(x, y, w, TO_FIXED(1), 0xFFFF00, 0xC0, INK_ALPHA, false);
+                    if (info->collision & 1) // top
+                        DrawRectangle(x, y, w, TO_FIXED(1), 0xFFFF00, 0xC0, INK_ALPHA, false);
 
-                            if (info->collision & 8) // bottom
-                                DrawRectangle(x, y + h, w, TO_FIXED(1), 0xFFFF00, 0xC0, INK_ALPHA, false);
-                            break;
-                    }
-                }
+                    if (info->collision & 8) // bottom
+                        DrawRectangle(x, y + h, w, TO_FIXED(1), 0xFFFF00, 0xC0, INK_ALPHA, false);
+                    break;
             }
+        }
+    }
 
-            if (engine.showPaletteOverlay) {
-                for (int32 p = 0; p < PALETTE_BANK_COUNT; ++p) {
-                    int32 x = (videoSettings.pixWidth - (0x10 << 3));
-                    int32 y = (SCREEN_YSIZE - (0x10 << 2));
+    if (engine.showPaletteOverlay) {
+        for (int32 p = 0; p < PALETTE_BANK_COUNT; ++p) {
+            int32 x = (videoSettings.pixWidth - (0x10 << 3));
+            int32 y = (SCREEN_YSIZE - (0x10 << 2));
 
-                    for (int32 c = 0; c < PALETTE_BANK_SIZE; ++c) {
-                        uint32 clr = GetPaletteEntry(p, c);
+            for (int32 c = 0; c < PALETTE_BANK_SIZE; ++c) {
+                uint32 clr = GetPaletteEntry(p, c);
 
-                        DrawRectangle(x + ((c & 0xF) << 1) + ((p % (PALETTE_BANK_COUNT / 2)) * (2 * 16)),
-                                      y + ((c >> 4) << 1) + ((p / (PALETTE_BANK_COUNT / 2)) * (2 * 16)), 2, 2, clr, 0xFF, INK_NONE, true);
-                    }
-                }
+                DrawRectangle(x + ((c & 0xF) << 1) + ((p % (PALETTE_BANK_COUNT / 2)) * (2 * 16)),
+                              y + ((c >> 4) << 1) + ((p / (PALETTE_BANK_COUNT / 2)) * (2 * 16)), 2, 2, clr, 0xFF, INK_NONE, true);
+            }
+        }
+    }
+
+#endif
+}
+
+static void ProcessScreenDrawLists(int32 screenID, bool32 checkPalette)
+{
+    currentScreen = &screens[screenID];
+
+    uint16 layerDrawList[DRAWGROUP_COUNT][LAYER_COUNT];
+    int32 layerCount[DRAWGROUP_COUNT];
+    BuildLayerDrawLists(screenID, layerDrawList, layerCount);
+
+    for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) {
+        if (engine.drawGroupVisible[l]) {
+            DrawGroupEntities(screenID, l);
+
+            for (int32 i = 0; i < layerCount[l]; ++i) {
+                TileLayer *layer = &tileLayers[layerDrawList[l][i]];
+
+                ProcessLayerScanlines(layer);
+                DrawLayer(layer);
             }
 
+            FinishDrawGroup(l);
+#if RETRO_USE_THREADS
+            if (checkPalette)
+                CheckDrawPalette();
+#else
+            (void)checkPalette;
 #endif
+        }
+    }
+
+    DrawScreenOverlays(screenID);
+}
+
+#if RETRO_USE_THREADS
+static void DrawScreenLayersJob(void *data, int32 screenID)
+{
+    int32 drawGroup = *(int32 *)data;
 
-            currentScreen++;
-            sceneInfo.currentScreenID++;
+    currentScreen = &screens[screenID];
+    layerPalette  = screenLayerPalettes[screenID];
+    for (int32 i = 0; i < screenLayerCount[screenID][drawGroup]; ++i) {
+        scanlines     = layerScanlines[screenID][i];
+        gfxLineBuffer = layerLineBuffers[screenID][i];
+
+        DrawLayer(&tileLayers[screenLayerDrawList[screenID][drawGroup][i]]);
+    }
+    layerPalette = fullPalette;
+}
+
+static void ProcessScreenDrawListsParallel()
+{
+    int32 screenCount = videoSettings.screenCount;
+    for (int32 s = 0; s < screenCount; ++s) BuildLayerDrawLists(s, screenLayerDrawList[s], screenLayerCount[s]);
+
+    // draw groups are processed in lockstep: every screen runs its callbacks (in screen order) before its layers are drawn in parallel.
+    // nothing can touch palettes, layers or scroll data while the rasterisation is running, but callbacks see other screens' changes earlier
+    for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) {
+        if (!engine.drawGroupVisible[l])
+            continue;
+
+        bool32 hasLayers = false;
+        for (int32 s = 0; s < screenCount; ++s) {
+            currentScreen = &screens[s];
+            gfxLineBuffer = screenLineBuffers[s];
+
+            DrawGroupEntities(s, l);
+
+            for (int32 i = 0; i < screenLayerCount[s][l]; ++i) {
+                scanlines = layerScanlines[s][i];
+                ProcessLayerScanlines(&tileLayers[screenLayerDrawList[s][l][i]]);
+                memcpy(layerLineBuffers[s][i], gfxLineBuffer, SCREEN_YSIZE * sizeof(uint8));
+                hasLayers = true;
+            }
+            CheckDrawPalette();
+
+            // the last screen's callbacks are the last to run, so it can use the palette as it is
+            screenLayerPalettes[s] = fullPalette;
+            if (screenLayerCount[s][l] && s + 1 < screenCount) {
+                memcpy(screenPalettes[s], fullPalette, sizeof(fullPalette));
+                screenLayerPalettes[s] = screenPalettes[s];
+            }
+        }
+
+        if (hasLayers)
+            RunWorkerJobs(DrawScreenLayersJob, &l, screenCount);
+
+        for (int32 s = 0; s < screenCount; ++s) {
+            currentScreen              = &screens[s];
+            gfxLineBuffer              = screenLineBuffers[s];
+            sceneInfo.currentScreenID  = s;
+            sceneInfo.currentDrawGroup = l;
+
+            FinishDrawGroup(l);
+            CheckDrawPalette();
         }
     }
+
+    for (int32 s = 0; s < screenCount; ++s) {
+        gfxLineBuffer = screenLineBuffers[s];
+        DrawScreenOverlays(s);
+    }
+}
+#endif
+
+void RSDK::ProcessObjectDrawLists()
+{
+    if (sceneInfo.state != ENGINESTATE_LOAD && sceneInfo.state != (ENGINESTATE_LOAD | ENGINESTATE_STEPOVER)) {
+#if RETRO_USE_THREADS
+        bool32 checkPalette = customSettings.parallelScreens && videoSettings.screenCount > 1 && workerThreadCount;
+        if (checkPalette) {
+            memcpy(drawPalette, fullPalette, sizeof(fullPalette));
+            drawPaletteChanged = false;
+        }
+
+        if (checkPalette && parallelScreenDraws) {
+            // every screen gets its own active palette lines, so screens can't overwrite each other's mid-draw
+            ScanlineInfo *mainScanlines = scanlines;
+            uint8 *mainLineBuffer       = gfxLineBuffer;
+            for (int32 s = 0; s < videoSettings.screenCount; ++s) memcpy(screenLineBuffers[s], mainLineBuffer, SCREEN_YSIZE * sizeof(uint8));
+
+            ProcessScreenDrawListsParallel();
+
+            scanlines     = mainScanlines;
+            gfxLineBuffer = mainLineBuffer;
+            memcpy(gfxLineBuffer, screenLineBuffers[videoSettings.screenCount - 1], SCREEN_YSIZE * sizeof(uint8));
+        }
+        else
+#else
+        bool32 checkPalette = false;
+#endif
+        {
+            for (int32 s = 0; s < videoSettings.screenCount; ++s) ProcessScreenDrawLists(s, checkPalette);
+        }
+
+#if RETRO_USE_THREADS
+        if (checkPalette)
+            parallelScreenDraws = !drawPaletteChanged;
+#endif
+
+        // match the state the screen loop has always left behind
+        currentScreen              = &screens[videoSettings.screenCount];
+        sceneInfo.currentScreenID  = videoSettings.screenCount;
+        sceneInfo.currentDrawGroup = DRAWGROUP_COUNT;
+    }
 }
 
 uint16 RSDK::FindObject(const char *name)
@@ -1008,13 +1557,52 @@ uint16 RSDK::FindObject(const char *name)
     RETRO_HASH_MD5(hash);
     GEN_HASH_MD5(name, hash);
 
+#if !RETRO_USE_ORIGINAL_CODE
+    return FindObjectByHash(hash);
+#else
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
         if (HASH_MATCH_MD5(hash, objectClassList[stageObjectIDs[o]].hash))
             return o;
     }
 
+    return TYPE_DEFAULTOBJECT;
+#endif
+}
+
+#if !RETRO_USE_ORIGINAL_CODE
+void RSDK::BuildClassHashTable()
+{
+    memset(classHashTable.entries, 0, sizeof(classHashTable.entries));
+
+    for (int32 o = 0; o < sceneInfo.classCount; ++o) {
+        uint32 *hash = objectClassList[stageObjectIDs[o]].hash;
+
+        // the same class can be in the stage list more than once, lookups have always found the first one
+        uint32 pos = hash[0] & (CLASSHASH_TABLE_SIZE - 1);
+        while (classHashTable.entries[pos] && !HASH_MATCH_MD5(objectClassList[stageObjectIDs[classHashTable.entries[pos] - 1]].hash, hash))
+            pos = (pos + 1) & (CLASSHASH_TABLE_SIZE - 1);
+
+        if (!classHashTable.entries[pos])
+            classHashTable.entries[pos] = o + 1;
+    }
+
+    classHashTable.outdated = false;
+}
+
+uint16 RSDK::FindObjectByHash(const uint32 *hash)
+{
+    if (classHashTable.outdated)
+        BuildClassHashTable();
+
+    for (uint32 pos = hash[0] & (CLASSHASH_TABLE_SIZE - 1); classHashTable.entries[pos]; pos = (pos + 1) & (CLASSHASH_TABLE_SIZE - 1)) {
+        uint16 classID = classHashTable.entries[pos] - 1;
+        if (HASH_MATCH_MD5(hash, objectClassList[stageObjectIDs[classID]].hash))
+            return classID;
+    }
+
     return TYPE_DEFAULTOBJECT;
 }
+#endif
 
 int32 RSDK::GetEntityCount(uint16 classID, bool32 isActive)
 {
@@ -1024,10 +1612,20 @@ int32 RSDK::GetEntityCount(uint16 classID, bool32 isActive)
         return typeGroups[classID].entryCount;
 
     int32 entityCount = 0;
+#if !RETRO_USE_ORIGINAL_CODE
+    const uint32 *slots = entityClassIndex.slots[classID];
+    for (int32 i = FindNextClassSlot(slots, 0); i < ENTITY_COUNT; i = FindNextClassSlot(slots, i + 1)) {
+        if (objectEntityList[i].classID == classID)
+            entityCount++;
+        else
+            UpdateEntityClassIndex(i);
+    }
+#else
     for (int32 i = 0; i < ENTITY_COUNT; ++i) {
         if (objectEntityList[i].classID == classID)
             entityCount++;
     }
+#endif
 
     return entityCount;
 }
@@ -1057,6 +1655,10 @@ void RSDK::ResetEntity(Entity *entity, uint16 classID, void *data)
         }
 
         entity->classID = classID;
+
+#if !RETRO_USE_ORIGINAL_CODE
+        UpdateEntityClassIndex(entity);
+#endif
     }
 }
 
@@ -1088,6 +1690,10 @@ void RSDK::ResetEntitySlot(uint16 slot, uint16 classID, void *data)
     else {
         entity->classID = classID;
     }
+
+#if !RETRO_USE_ORIGINAL_CODE
+    UpdateEntityClassIndex(slot);
+#endif
 }
 
 Entity *RSDK::CreateEntity(uint16 classID, void *data, int32 x, int32 y)
@@ -1146,6 +1752,10 @@ Entity *RSDK::CreateEntity(uint16 classID, void *data, int32 x, int32 y)
         entity->visible = true;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    UpdateEntityClassIndex(entity);
+#endif
+
     return entity;
 }
 
@@ -1193,6 +1803,27 @@ bool32 RSDK::GetAllEntities(uint16 classID, Entity **entity)
         foreachStackPtr->id = 0;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    if (classID < TYPE_COUNT) {
+        // same slot order as the full scan, the index just lets us jump straight to the next candidate
+        const uint32 *slots = entityClassIndex.slots[classID];
+        for (foreachStackPtr->id = FindNextClassSlot(slots, foreachStackPtr->id); foreachStackPtr->id < ENTITY_COUNT;
+             foreachStackPtr->id = FindNextClassSlot(slots, foreachStackPtr->id + 1)) {
+            Entity *nextEntity = &objectEntityList[foreachStackPtr->id];
+            if (nextEntity->classID == classID) {
+                *entity = nextEntity;
+                return true;
+            }
+
+            UpdateEntityClassIndex(foreachStackPtr->id);
+        }
+
+        foreachStackPtr--;
+
+        return false;
+    }
+#endif
+
     for (; foreachStackPtr->id < ENTITY_COUNT; ++foreachStackPtr->id) {
         Entity *nextEntity = &objectEntityList[foreachStackPtr->id];
         if (nextEntity->classID == classID) {
@@ -1206,6 +1837,121 @@ bool32 RSDK::GetAllEntities(uint16 classID, Entity **entity)
     return false;
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+static inline int32 GetEntityGridBucket(int32 cellX, int32 cellY)
+{
+    return (int32)(((uint32)cellX * 0x9E3779B1 ^ (uint32)cellY * 0x85EBCA77) >> (32 - ENTITYGRID_BUCKET_BITS));
+}
+
+void RSDK::BuildEntityGrid()
+{
+    TypeGroupList *list = &typeGroups[GROUP_ALL];
+
+    uint16 buckets[ENTITY_COUNT];
+    memset(entityGrid.bucketStart, 0, sizeof(entityGrid.bucketStart));
+    for (int32 i = 0; i < list->entryCount; ++i) {
+        Entity *entity = &objectEntityList[list->entries[i]];
+
+        int32 cellX = FROM_FIXED(entity->position.x) >> ENTITYGRID_CELL_SHIFT;
+        int32 cellY = FROM_FIXED(entity->position.y) >> ENTITYGRID_CELL_SHIFT;
+        buckets[i]  = GetEntityGridBucket(cellX, cellY);
+        entityGrid.bucketStart[buckets[i] + 1]++;
+    }
+
+    for (int32 b = 0; b < ENTITYGRID_BUCKET_COUNT; ++b) entityGrid.bucketStart[b + 1] += entityGrid.bucketStart[b];
+
+    uint16 cursors[ENTITYGRID_BUCKET_COUNT];
+    memcpy(cursors, entityGrid.bucketStart, sizeof(cursors));
+    for (int32 i = 0; i < list->entryCount; ++i) entityGrid.entries[cursors[buckets[i]]++] = list->entries[i];
+
+    entityGrid.outdated = false;
+}
+
+bool32 RSDK::GetEntitiesInArea(uint16 group, Entity *entity, Hitbox *hitbox, int32 range, Entity **next)
+{
+    if (group >= TYPEGROUP_COUNT)
+        return false;
+
+    if (!entity || !hitbox || !next)
+        return false;
+
+    if (entityGrid.outdated)
+        BuildEntityGrid();
+
+    if (*next) {
+        ++foreachStackPtr->id;
+    }
+    else {
+        foreachStackPtr++;
+        foreachStackPtr->id   = 0;
+        foreachStackPtr->cell = 0;
+    }
+
+    // hitboxes get flipped the same way CheckObjectCollisionTouch flips them
+    int32 left   = (entity->direction & FLIP_X) ? -hitbox->right : hitbox->left;
+    int32 right  = (entity->direction & FLIP_X) ? -hitbox->left : hitbox->right;
+    int32 top    = (entity->direction & FLIP_Y) ? -hitbox->bottom : hitbox->top;
+    int32 bottom = (entity->direction & FLIP_Y) ? -hitbox->top : hitbox->bottom;
+
+    left += FROM_FIXED(entity->position.x) - range;
+    right += FROM_FIXED(entity->position.x) + range;
+    top += FROM_FIXED(entity->position.y) - range;
+    bottom += FROM_FIXED(entity->position.y) + range;
+
+    int32 cellLeft   = left >> ENTITYGRID_CELL_SHIFT;
+    int32 cellTop    = top >> ENTITYGRID_CELL_SHIFT;
+    int32 cellWidth  = (right >> ENTITYGRID_CELL_SHIFT) - cellLeft + 1;
+    int32 cellHeight = (bottom >> ENTITYGRID_CELL_SHIFT) - cellTop + 1;
+
+    bool32 allBuckets = cellWidth > ENTITYGRID_QUERY_CELLS || cellHeight > ENTITYGRID_QUERY_CELLS || cellWidth * cellHeight > ENTITYGRID_QUERY_CELLS;
+    int32 cellCount   = allBuckets ? ENTITYGRID_BUCKET_COUNT : cellWidth * cellHeight;
+
+    for (; foreachStackPtr->cell < cellCount; ++foreachStackPtr->cell, foreachStackPtr->id = 0) {
+        int32 cell   = foreachStackPtr->cell;
+        int32 bucket = cell;
+
+        if (!allBuckets) {
+            bucket = GetEntityGridBucket(cellLeft + cell % cellWidth, cellTop + cell / cellWidth);
+
+            // two cells in the area can hash to the same bucket, so only the first one gets to walk it
+            if (!foreachStackPtr->id) {
+                int32 c = 0;
+                for (; c < cell; ++c) {
+                    if (GetEntityGridBucket(cellLeft + c % cellWidth, cellTop + c / cellWidth) == bucket)
+                        break;
+                }
+
+                if (c < cell)
+                    continue;
+            }
+        }
+
+        int32 start = entityGrid.bucketStart[bucket];
+        int32 count = entityGrid.bucketStart[bucket + 1] - start;
+        for (; foreachStackPtr->id < count; ++foreachStackPtr->id) {
+            Entity *other = &objectEntityList[entityGrid.entries[start + foreachStackPtr->id]];
+            if (other == entity)
+                continue;
+
+            if (group != GROUP_ALL && (group < TYPE_COUNT ? other->classID != group : other->group != group))
+                continue;
+
+            // buckets can hold entities from other cells (or ones that have moved since), so the position is always checked
+            int32 x = FROM_FIXED(other->position.x);
+            int32 y = FROM_FIXED(other->position.y);
+            if (x >= left && x <= right && y >= top && y <= bottom) {
+                *next = other;
+                return true;
+            }
+        }
+    }
+
+    foreachStackPtr--;
+
+    return false;
+}
+#endif
+
 bool32 RSDK::CheckOnScreen(Entity *entity, Vector2 *range)
 {
     if (!entity)
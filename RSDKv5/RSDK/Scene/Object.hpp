@@ -182,6 +182,10 @@ struct ObjectClass {
 
 #if !RETRO_USE_ORIGINAL_CODE
     const char *name; // for debugging purposes
+
+    // set through SetClassParallelUpdate, these take the entity since sceneInfo.entity is shared by every thread
+    void (*parallelUpdate)(void *entity);
+    void (*parallelLateUpdate)(void *entity);
 #endif
 };
 
@@ -194,6 +198,9 @@ struct EditableVarInfo {
 
 struct ForeachStackInfo {
     int32 id;
+#if !RETRO_USE_ORIGINAL_CODE
+    int32 cell; // used by GetEntitiesInArea
+#endif
 };
 
 struct TypeGroupList {
@@ -201,6 +208,39 @@ struct TypeGroupList {
     int32 entryCount;
 };
 
+#if !RETRO_USE_ORIGINAL_CODE
+#define ENTITYCLASS_INDEX_WORDS ((ENTITY_COUNT + 31) / 32)
+
+// one bitmap of slots per class, so GetAllEntities & GetEntityCount only visit the slots that (probably) hold that class
+// a set bit is only a hint, the entity's classID is always checked again before it's used
+struct EntityClassIndex {
+    uint32 slots[TYPE_COUNT][ENTITYCLASS_INDEX_WORDS];
+    uint16 classIDs[ENTITY_COUNT]; // the class each slot is currently filed under
+};
+
+// active entities get bucketed by the 128x128 pixel cell their position is in. cells are hashed into a fixed number of buckets,
+// so the grid doesn't care how big the stage is
+#define ENTITYGRID_CELL_SHIFT   (7)
+#define ENTITYGRID_BUCKET_BITS  (10)
+#define ENTITYGRID_BUCKET_COUNT (1 << ENTITYGRID_BUCKET_BITS)
+// areas covering more cells than this just walk every bucket
+#define ENTITYGRID_QUERY_CELLS (0x40)
+
+struct EntityGrid {
+    uint16 bucketStart[ENTITYGRID_BUCKET_COUNT + 1];
+    uint16 entries[ENTITY_COUNT];
+    bool32 outdated;
+};
+
+// stage classIDs by the MD5 of their name, open-addressed with room for twice the stage class limit so probes stay short
+#define CLASSHASH_TABLE_SIZE (TYPE_COUNT * 2)
+
+struct ClassHashTable {
+    uint16 entries[CLASSHASH_TABLE_SIZE]; // classID + 1, 0 is an empty entry
+    bool32 outdated;
+};
+#endif
+
 extern ObjectClass objectClassList[OBJECT_COUNT];
 extern int32 objectClassCount;
 
@@ -221,7 +261,13 @@ extern ForeachStackInfo *foreachStackPtr;
 
 extern TypeGroupList typeGroups[TYPEGROUP_COUNT];
 
-extern bool32 validDraw;
+#if !RETRO_USE_ORIGINAL_CODE
+extern EntityClassIndex entityClassIndex;
+extern EntityGrid entityGrid;
+extern ClassHashTable classHashTable;
+#endif
+
+extern RETRO_THREAD_LOCAL bool32 validDraw;
 
 #if RETRO_REV0U
 void RegisterObject(Object **staticVars, const char *name, uint32 entityClassSize, uint32 staticClassSize, void (*update)(), void (*lateUpdate)(),
@@ -247,6 +293,13 @@ void RegisterObject_STD(Object **staticVars, const char *name, uint32 entityClas
 #endif
 #endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+// marks the class as parallel-safe: in-range entities of it get these called across the worker threads (after the rest of the pass) instead of
+// the class' own update/lateUpdate. they must only write to the entity they're given & can't call anything that changes shared engine state
+// (creating/resetting entities, draw lists, sceneInfo, etc). with no worker threads they're still held back & run after the pass, on the main thread
+void SetClassParallelUpdate(const char *name, void (*update)(void *entity), void (*lateUpdate)(void *entity));
+#endif
+
 #if RETRO_REV02 || RETRO_USE_MOD_LOADER
 void RegisterStaticVariables(void **varClass, const char *name, uint32 classSize);
 #endif
@@ -289,6 +342,13 @@ void ProcessFrozenObjects();
 void ProcessObjectDrawLists();
 
 uint16 FindObject(const char *name);
+#if !RETRO_USE_ORIGINAL_CODE
+// rebuilt by the first lookup after the stage class list or the registered classes change
+void BuildClassHashTable();
+inline void InvalidateClassHashTable() { classHashTable.outdated = true; }
+// same as scanning the stage classes for the first one with this hash, TYPE_DEFAULTOBJECT if there isn't one
+uint16 FindObjectByHash(const uint32 *hash);
+#endif
 
 inline Entity *GetEntity(uint16 slot) { return &objectEntityList[slot < ENTITY_COUNT ? slot : (ENTITY_COUNT - 1)]; }
 inline int32 GetEntitySlot(EntityBase *entity) { return (int32)((uint32)(entity - objectEntityList) < ENTITY_COUNT ? entity - objectEntityList : 0); }
@@ -298,6 +358,24 @@ void ResetEntity(Entity *entity, uint16 classID, void *data);
 void ResetEntitySlot(uint16 slot, uint16 classID, void *data);
 Entity *CreateEntity(uint16 classID, void *data, int32 x, int32 y);
 
+#if !RETRO_USE_ORIGINAL_CODE
+// files the slot under its entity's current classID
+void UpdateEntityClassIndex(uint16 slot);
+inline void UpdateEntityClassIndex(void *entity)
+{
+    uint32 slot = (uint32)((EntityBase *)entity - objectEntityList);
+    if (slot < ENTITY_COUNT)
+        UpdateEntityClassIndex((uint16)slot);
+}
+// refiles every slot from scratch, used after the entity list gets overwritten in bulk (scene loads)
+void RebuildEntityClassIndex();
+// catches up with any classIDs that were changed without going through the engine (game code writing classID directly)
+// only empty slots are checked, the update passes refile the occupied ones as they visit them
+void SyncEntityClassIndex();
+// checks the index against a full scan of the entity list, returns false (and logs the slot) on the first mismatch
+bool32 ValidateEntityClassIndex();
+#endif
+
 inline void CopyEntity(void *destEntity, void *srcEntity, bool32 clearSrcEntity)
 {
     if (destEntity && srcEntity) {
@@ -305,12 +383,28 @@ inline void CopyEntity(void *destEntity, void *srcEntity, bool32 clearSrcEntity)
 
         if (clearSrcEntity)
             memset(srcEntity, 0, sizeof(EntityBase));
+
+#if !RETRO_USE_ORIGINAL_CODE
+        UpdateEntityClassIndex(destEntity);
+        if (clearSrcEntity)
+            UpdateEntityClassIndex(srcEntity);
+#endif
     }
 }
 
 bool32 GetActiveEntities(uint16 group, Entity **entity);
 bool32 GetAllEntities(uint16 classID, Entity **entity);
 
+#if !RETRO_USE_ORIGINAL_CODE
+// buckets typeGroups[GROUP_ALL] by position, this is done by the first query after the type groups get rebuilt
+void BuildEntityGrid();
+inline void InvalidateEntityGrid() { entityGrid.outdated = true; }
+// foreach loop over the active entities in group whose position is within hitbox (around entity), grown by range pixels on every side.
+// the grid only knows where entities were when it was built, so range should cover how far they can move in a frame on top of the
+// size of their own hitboxes. the entities aren't returned in slot order
+bool32 GetEntitiesInArea(uint16 group, Entity *entity, Hitbox *hitbox, int32 range, Entity **next);
+#endif
+
 inline void BreakForeachLoop() { --foreachStackPtr; }
 
 // CheckPosOnScreen but if range is NULL it'll use entity->updateRange
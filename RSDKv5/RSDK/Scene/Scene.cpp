@@ -8,7 +8,7 @@ using namespace RSDK;
 
 uint8 RSDK::tilesetPixels[TILESET_SIZE * 4];
 
-ScanlineInfo *RSDK::scanlines = NULL;
+RETRO_THREAD_LOCAL ScanlineInfo *RSDK::scanlines = NULL;
 TileLayer RSDK::tileLayers[LAYER_COUNT];
 CollisionMask RSDK::collisionMasks[CPATH_COUNT][TILE_COUNT * 4];
 TileInfo RSDK::tileInfo[CPATH_COUNT][TILE_COUNT * 4];
@@ -21,6 +21,177 @@ char RSDK::currentSceneID[0x10];
 
 SceneInfo RSDK::sceneInfo;
 
+#if !RETRO_USE_ORIGINAL_CODE
+SceneSnapshot RSDK::sceneSnapshot;
+
+static int64 sceneLoadStart = 0;
+#endif
+
+void (*RSDK::DrawTileRow)(uint16 *frameBuffer, const uint8 *pixels, const uint16 *palette) = DrawTileRow_Scalar;
+
+void RSDK::DrawTileRow_Scalar(uint16 *frameBuffer, const uint8 *pixels, const uint16 *palette)
+{
+    for (int32 x = 0; x < TILE_SIZE; ++x) {
+        uint8 index = pixels[x];
+        if (index)
+            frameBuffer[x] = palette[index];
+    }
+}
+
+#if RETRO_USE_SSE2
+void RSDK::DrawTileRow_SSE2(uint16 *frameBuffer, const uint8 *pixels, const uint16 *palette)
+{
+    // 0xFF for every transparent (index 0) pixel
+    __m128i mask = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)pixels), _mm_setzero_si128());
+    int32 bits   = _mm_movemask_epi8(mask);
+    if (bits == 0xFFFF)
+        return;
+
+    // there's no 16-bit gather, so the palette lookup stays scalar
+    uint16 colors[TILE_SIZE];
+    for (int32 x = 0; x < TILE_SIZE; ++x) colors[x] = palette[pixels[x]];
+
+    __m128i colorsLo = _mm_loadu_si128((const __m128i *)colors);
+    __m128i colorsHi = _mm_loadu_si128((const __m128i *)&colors[8]);
+    if (!bits) {
+        _mm_storeu_si128((__m128i *)frameBuffer, colorsLo);
+        _mm_storeu_si128((__m128i *)&frameBuffer[8], colorsHi);
+        return;
+    }
+
+    __m128i maskLo = _mm_unpacklo_epi8(mask, mask);
+    __m128i maskHi = _mm_unpackhi_epi8(mask, mask);
+    __m128i dstLo  = _mm_loadu_si128((const __m128i *)frameBuffer);
+    __m128i dstHi  = _mm_loadu_si128((const __m128i *)&frameBuffer[8]);
+    _mm_storeu_si128((__m128i *)frameBuffer, _mm_or_si128(_mm_and_si128(maskLo, dstLo), _mm_andnot_si128(maskLo, colorsLo)));
+    _mm_storeu_si128((__m128i *)&frameBuffer[8], _mm_or_si128(_mm_and_si128(maskHi, dstHi), _mm_andnot_si128(maskHi, colorsHi)));
+}
+#endif
+
+#if RETRO_USE_NEON
+void RSDK::DrawTileRow_NEON(uint16 *frameBuffer, const uint8 *pixels, const uint16 *palette)
+{
+    uint8x16_t mask = vceqq_u8(vld1q_u8(pixels), vdupq_n_u8(0));
+    if (vminvq_u8(mask) == 0xFF)
+        return;
+
+    uint16 colors[TILE_SIZE];
+    for (int32 x = 0; x < TILE_SIZE; ++x) colors[x] = palette[pixels[x]];
+
+    uint16x8_t maskLo = vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(vget_low_u8(mask))));
+    uint16x8_t maskHi = vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(vget_high_u8(mask))));
+    vst1q_u16(frameBuffer, vbslq_u16(maskLo, vld1q_u16(frameBuffer), vld1q_u16(colors)));
+    vst1q_u16(&frameBuffer[8], vbslq_u16(maskHi, vld1q_u16(&frameBuffer[8]), vld1q_u16(&colors[8])));
+}
+#endif
+
+void RSDK::InitTileRowKernels()
+{
+    DrawTileRow = DrawTileRow_Scalar;
+
+#if RETRO_USE_SSE2
+    DrawTileRow = DrawTileRow_SSE2;
+#endif
+
+#if RETRO_USE_NEON
+    DrawTileRow = DrawTileRow_NEON;
+#endif
+}
+
+#if !RETRO_USE_ORIGINAL_CODE
+void RSDK::BenchmarkTileRows()
+{
+    struct TileRowKernel {
+        const char *name;
+        void (*draw)(uint16 *frameBuffer, const uint8 *pixels, const uint16 *palette);
+    };
+
+    TileRowKernel kernels[3];
+    int32 kernelCount      = 0;
+    kernels[kernelCount++] = { "Scalar", DrawTileRow_Scalar };
+#if RETRO_USE_SSE2
+    kernels[kernelCount++] = { "SSE2", DrawTileRow_SSE2 };
+#endif
+#if RETRO_USE_NEON
+    kernels[kernelCount++] = { "NEON", DrawTileRow_NEON };
+#endif
+
+    // a 424x240 screen, drawn from a 64 tile set
+    const int32 width     = 424;
+    const int32 height    = SCREEN_YSIZE;
+    const int32 tileCount = 64;
+    const int32 frames    = 100;
+
+    uint16 *frameBuffer = NULL;
+    uint16 *reference   = NULL;
+    uint8 *pixels       = NULL;
+    uint16 *palette     = NULL;
+    AllocateStorage((void **)&frameBuffer, width * height * sizeof(uint16), DATASET_TMP, false);
+    AllocateStorage((void **)&reference, width * height * sizeof(uint16), DATASET_TMP, false);
+    AllocateStorage((void **)&pixels, tileCount * TILE_DATASIZE, DATASET_TMP, false);
+    AllocateStorage((void **)&palette, PALETTE_BANK_SIZE * sizeof(uint16), DATASET_TMP, false);
+    if (!frameBuffer || !reference || !pixels || !palette) {
+        PrintLog(PRINT_NORMAL, "Tile row benchmark: couldn't allocate its buffers");
+        RemoveStorageEntry((void **)&frameBuffer);
+        RemoveStorageEntry((void **)&reference);
+        RemoveStorageEntry((void **)&pixels);
+        RemoveStorageEntry((void **)&palette);
+        return;
+    }
+
+    for (int32 c = 0; c < PALETTE_BANK_SIZE; ++c) palette[c] = (c * 0x9E37) & 0x7FFF;
+
+    // opaque tiles are the fast path, fully transparent rows get skipped & mixed ones need the masked blend
+    const char *layoutNames[] = { "opaque", "transparent", "mixed" };
+    for (int32 l = 0; l < 3; ++l) {
+        int32 seed = 0x1234;
+        for (int32 p = 0; p < tileCount * TILE_DATASIZE; ++p) {
+            int32 index = RandSeeded(1, 0x100, &seed);
+            switch (l) {
+                default:
+                case 0: pixels[p] = index; break;
+                case 1: pixels[p] = 0; break;
+                case 2: pixels[p] = RandSeeded(0, 4, &seed) ? index : 0; break;
+            }
+        }
+
+        int32 scalarTime = 0;
+        for (int32 k = 0; k < kernelCount; ++k) {
+            void (*draw)(uint16 *frameBuffer, const uint8 *pixels, const uint16 *palette) = kernels[k].draw;
+
+            // redrawing the same rows gives the same result, so the buffer only needs clearing once
+            memset(frameBuffer, 0, width * height * sizeof(uint16));
+
+            int64 start = GetEngineTime();
+            for (int32 f = 0; f < frames; ++f) {
+                for (int32 y = 0; y < height; ++y) {
+                    uint16 *row = &frameBuffer[y * width];
+                    for (int32 x = 0; x + TILE_SIZE <= width; x += TILE_SIZE) {
+                        int32 tile = (x / TILE_SIZE + (y / TILE_SIZE) * 7) % tileCount;
+                        draw(&row[x], &pixels[(tile * TILE_SIZE + (y & 0xF)) * TILE_SIZE], palette);
+                    }
+                }
+            }
+            int32 time = (int32)(GetEngineTime() - start);
+
+            if (!k) {
+                scalarTime = time;
+                memcpy(reference, frameBuffer, width * height * sizeof(uint16));
+            }
+            bool32 matches = !memcmp(reference, frameBuffer, width * height * sizeof(uint16));
+
+            PrintLog(PRINT_NORMAL, "Tile rows (%s, %s): %.3fms per %dx%d frame, %.2fx scalar%s", layoutNames[l], kernels[k].name,
+                     time / 1000.0f / frames, width, height, time ? (float)scalarTime / time : 0.0f, matches ? "" : ", OUTPUT DIFFERS");
+        }
+    }
+
+    RemoveStorageEntry((void **)&frameBuffer);
+    RemoveStorageEntry((void **)&reference);
+    RemoveStorageEntry((void **)&pixels);
+    RemoveStorageEntry((void **)&palette);
+}
+#endif
+
 void RSDK::LoadSceneFolder()
 {
 #if RETRO_PLATFORM == RETRO_ANDROID
@@ -37,6 +208,13 @@ void RSDK::LoadSceneFolder()
     sceneInfo.seconds      = 0;
     sceneInfo.milliseconds = 0;
 
+#if !RETRO_USE_ORIGINAL_CODE
+    ClearSceneSnapshot();
+
+    sceneLoadStart    = GetEngineTime();
+    preloadedFileHits = 0;
+#endif
+
     // clear draw groups
     for (int32 i = 0; i < DRAWGROUP_COUNT; ++i) {
         drawGroups[i].entityCount = 0;
@@ -47,6 +225,9 @@ void RSDK::LoadSceneFolder()
     for (int32 i = 0; i < TYPEGROUP_COUNT; ++i) {
         typeGroups[i].entryCount = 0;
     }
+#if !RETRO_USE_ORIGINAL_CODE
+    InvalidateEntityGrid();
+#endif
 
 #if RETRO_REV02
     // Unload debug values
@@ -135,6 +316,12 @@ void RSDK::LoadSceneFolder()
     DefragmentAndGarbageCollectStorage(DATASET_STG);
     DefragmentAndGarbageCollectStorage(DATASET_SFX);
 
+#if RETRO_USE_STORAGE_TELEMETRY
+    // anything still in stage storage at this point has outlived the scene it was loaded for
+    if (currentSceneFolder[0])
+        DumpStorageTelemetry(currentSceneFolder);
+#endif
+
     for (int32 s = 0; s < SCREEN_COUNT; ++s) {
         screens[s].position.x = 0;
         screens[s].position.y = 0;
@@ -200,6 +387,9 @@ void RSDK::LoadSceneFolder()
                 }
             }
         }
+#if !RETRO_USE_ORIGINAL_CODE
+        InvalidateClassHashTable();
+#endif
 
         for (int32 o = 0; o < sceneInfo.classCount; ++o) {
             ObjectClass *objClass = &objectClassList[stageObjectIDs[o]];
@@ -297,6 +487,39 @@ void RSDK::LoadSceneFolder()
 #endif
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+// indices into editableVarList (+ 1, 0 is empty) by var hash for the class being read, sized to at least twice the var count
+static uint16 editableVarTable[EDITABLEVAR_COUNT * 2];
+static uint32 editableVarTableMask = 0;
+
+static void BuildEditableVarTable()
+{
+    editableVarTableMask = 0xF;
+    while (editableVarTableMask + 1 < (uint32)editableVarCount * 2) editableVarTableMask = (editableVarTableMask << 1) | 1;
+    memset(editableVarTable, 0, (editableVarTableMask + 1) * sizeof(uint16));
+
+    for (int32 v = 0; v < editableVarCount; ++v) {
+        uint32 pos = editableVarList[v].hash[0] & editableVarTableMask;
+        while (editableVarTable[pos] && !HASH_MATCH_MD5(editableVarList[editableVarTable[pos] - 1].hash, editableVarList[v].hash))
+            pos = (pos + 1) & editableVarTableMask;
+
+        if (!editableVarTable[pos])
+            editableVarTable[pos] = v + 1;
+    }
+}
+
+static int32 FindEditableVar(const uint32 *hash)
+{
+    for (uint32 pos = hash[0] & editableVarTableMask; editableVarTable[pos]; pos = (pos + 1) & editableVarTableMask) {
+        int32 v = editableVarTable[pos] - 1;
+        if (HASH_MATCH_MD5(hash, editableVarList[v].hash))
+            return v;
+    }
+
+    return -1;
+}
+#endif
+
 void RSDK::LoadSceneAssets()
 {
 #if RETRO_PLATFORM == RETRO_ANDROID
@@ -309,7 +532,7 @@ void RSDK::LoadSceneAssets()
     char fullFilePath[0x40];
     sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Stages/%s/Scene%s.bin", currentSceneFolder, sceneEntry->id);
 
-    dataStorage[DATASET_TMP].usedStorage = 0;
+    ResetStorage(DATASET_TMP);
 
     for (int32 s = 0; s < SCREEN_COUNT; ++s) screens[s].waterDrawPos = screens[s].size.y;
 
@@ -443,6 +666,9 @@ void RSDK::LoadSceneAssets()
             objHash[2] = ReadInt32(&info, false);
             objHash[3] = ReadInt32(&info, false);
 
+#if !RETRO_USE_ORIGINAL_CODE
+            int32 classID = FindObjectByHash(objHash);
+#else
             int32 classID = 0;
             for (int32 o = 0; o < sceneInfo.classCount; ++o) {
                 if (HASH_MATCH_MD5(objHash, objectClassList[stageObjectIDs[o]].hash)) {
@@ -450,6 +676,7 @@ void RSDK::LoadSceneAssets()
                     break;
                 }
             }
+#endif
 
 #if !RETRO_USE_ORIGINAL_CODE
             if (!classID && i >= TYPE_DEFAULT_COUNT)
@@ -475,6 +702,10 @@ void RSDK::LoadSceneAssets()
                     objectClass->serialize();
             }
 
+#if !RETRO_USE_ORIGINAL_CODE
+            BuildEditableVarTable();
+#endif
+
             for (int32 e = 1; e < varCount; ++e) {
                 RETRO_HASH_MD5(varHash);
                 varHash[0] = ReadInt32(&info, false);
@@ -484,6 +715,15 @@ void RSDK::LoadSceneAssets()
 
                 int32 varID = 0;
                 MEM_ZERO(varList[e]);
+#if !RETRO_USE_ORIGINAL_CODE
+                int32 v = FindEditableVar(varHash);
+                if (v >= 0) {
+                    varID = v;
+                    HASH_COPY_MD5(varList[e].hash, editableVarList[v].hash);
+                    varList[e].offset = editableVarList[v].offset;
+                    varList[e].active = true;
+                }
+#else
                 for (int32 v = 0; v < editableVarCount; ++v) {
                     if (HASH_MATCH_MD5(varHash, editableVarList[v].hash)) {
                         varID = v;
@@ -493,6 +733,7 @@ void RSDK::LoadSceneAssets()
                         break;
                     }
                 }
+#endif
 
                 editableVarList[varID].type = varList[e].type = ReadInt8(&info);
             }
@@ -753,11 +994,21 @@ void RSDK::LoadSceneAssets()
 
         CloseFile(&info);
     }
+
+#if !RETRO_USE_ORIGINAL_CODE
+    RebuildEntityClassIndex();
+#endif
     
 #if RETRO_USE_MOD_LOADER
     LoadGameXML(true);
 #endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+    PrintLog(PRINT_NORMAL, "Scene load took %.2fms on the main thread (%d preloaded files used)",
+             (GetEngineTime() - sceneLoadStart) / 1000.0f, preloadedFileHits);
+    ReleasePreloadedFiles();
+#endif
+
 #if !RETRO_USE_ORIGINAL_CODE && RETRO_PLATFORM == RETRO_PS2
     printf("[PS2] Scene loaded: %d entity slots available\n", ENTITY_COUNT);
 #endif
@@ -1316,6 +1567,244 @@ void RSDK::SetScene(const char *categoryName, const char *sceneName)
     }
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+void RSDK::PreloadScene(const char *categoryName, const char *sceneName)
+{
+    RETRO_HASH_MD5(catHash);
+    GEN_HASH_MD5(categoryName, catHash);
+
+    RETRO_HASH_MD5(scnHash);
+    GEN_HASH_MD5(sceneName, scnHash);
+
+    SceneListEntry *sceneEntry = NULL;
+    for (int32 i = 0; i < sceneInfo.categoryCount && !sceneEntry; ++i) {
+        if (HASH_MATCH_MD5(sceneInfo.listCategory[i].hash, catHash)) {
+            for (int32 s = 0; s < sceneInfo.listCategory[i].sceneCount; ++s) {
+                if (HASH_MATCH_MD5(sceneInfo.listData[sceneInfo.listCategory[i].sceneOffsetStart + s].hash, scnHash)) {
+                    sceneEntry = &sceneInfo.listData[sceneInfo.listCategory[i].sceneOffsetStart + s];
+                    break;
+                }
+            }
+        }
+    }
+
+    if (!sceneEntry)
+        return;
+
+    char fullFilePath[0x40];
+    // staying in the same folder is a reload, which only reads the layout
+    if (strcmp(currentSceneFolder, sceneEntry->folder) != 0) {
+        sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Stages/%s/TileConfig.bin", sceneEntry->folder);
+        PreloadFile(fullFilePath);
+
+        sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Stages/%s/StageConfig.bin", sceneEntry->folder);
+        PreloadFile(fullFilePath);
+
+        sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Stages/%s/16x16Tiles.gif", sceneEntry->folder);
+        PreloadFile(fullFilePath);
+    }
+
+    sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Stages/%s/Scene%s.bin", sceneEntry->folder, sceneEntry->id);
+    PreloadFile(fullFilePath);
+}
+
+bool32 RSDK::CaptureSceneSnapshot()
+{
+    ClearSceneSnapshot();
+    SceneSnapshot *snapshot = &sceneSnapshot;
+
+    // the class index can lag behind classIDs set directly by game code, so the used slots come straight from the entities
+    int32 entityCount = 0;
+    memset(snapshot->usedSlots, 0, sizeof(snapshot->usedSlots));
+    for (int32 e = 0; e < ENTITY_COUNT; ++e) {
+        if (objectEntityList[e].classID) {
+            snapshot->usedSlots[e >> 5] |= 1u << (e & 0x1F);
+            ++entityCount;
+        }
+    }
+
+    if (entityCount) {
+        AllocateStorage((void **)&snapshot->entities, entityCount * sizeof(EntityBase), DATASET_STG, false);
+        if (!snapshot->entities)
+            return false;
+
+        EntityBase *entity = snapshot->entities;
+        for (int32 w = 0; w < ENTITYCLASS_INDEX_WORDS; ++w) {
+            for (uint32 bits = snapshot->usedSlots[w]; bits; bits &= bits - 1)
+                memcpy(entity++, &objectEntityList[(w << 5) + CountTrailingZeros(bits)], sizeof(EntityBase));
+        }
+    }
+
+    memcpy(snapshot->layers, tileLayers, sizeof(tileLayers));
+    for (int32 l = 0; l < LAYER_COUNT; ++l) {
+        TileLayer *layer = &tileLayers[l];
+        if (!layer->layout)
+            continue;
+
+        uint32 size = sizeof(uint16) * (1 << layer->widthShift) * (1 << layer->heightShift);
+        AllocateStorage((void **)&snapshot->layouts[l], size, DATASET_STG, false);
+        if (!snapshot->layouts[l]) {
+            ClearSceneSnapshot();
+            return false;
+        }
+
+        memcpy(snapshot->layouts[l], layer->layout, size);
+    }
+
+    for (int32 l = 0; l < LAYER_COUNT; ++l) {
+        TileLayer *layer = &tileLayers[l];
+        if (!layer->lineScroll)
+            continue;
+
+        uint32 size = TILE_SIZE * MAX(layer->xsize, layer->ysize);
+        AllocateStorage((void **)&snapshot->lineScrolls[l], size, DATASET_STG, false);
+        if (!snapshot->lineScrolls[l]) {
+            ClearSceneSnapshot();
+            return false;
+        }
+
+        memcpy(snapshot->lineScrolls[l], layer->lineScroll, size);
+    }
+
+    uint32 staticVarsSize = 0;
+    for (int32 o = 0; o < sceneInfo.classCount; ++o) {
+        ObjectClass *classInfo = &objectClassList[stageObjectIDs[o]];
+        if (classInfo->staticVars && *classInfo->staticVars)
+            staticVarsSize += classInfo->staticClassSize;
+    }
+
+    if (staticVarsSize) {
+        AllocateStorage((void **)&snapshot->staticVars, staticVarsSize, DATASET_STG, false);
+        if (!snapshot->staticVars) {
+            ClearSceneSnapshot();
+            return false;
+        }
+
+        uint8 *staticVars = snapshot->staticVars;
+        for (int32 o = 0; o < sceneInfo.classCount; ++o) {
+            ObjectClass *classInfo = &objectClassList[stageObjectIDs[o]];
+            if (classInfo->staticVars && *classInfo->staticVars) {
+                memcpy(staticVars, *classInfo->staticVars, classInfo->staticClassSize);
+                staticVars += classInfo->staticClassSize;
+            }
+        }
+    }
+
+    memcpy(snapshot->fullPalette, fullPalette, sizeof(fullPalette));
+    memcpy(snapshot->lineBuffer, gfxLineBuffer, SCREEN_YSIZE * sizeof(uint8));
+    memcpy(snapshot->cameras, cameras, sizeof(cameras));
+    snapshot->cameraCount  = cameraCount;
+    snapshot->entitySlot   = sceneInfo.entitySlot;
+    snapshot->createSlot   = sceneInfo.createSlot;
+    snapshot->timeCounter  = sceneInfo.timeCounter;
+    snapshot->milliseconds = sceneInfo.milliseconds;
+    snapshot->seconds      = sceneInfo.seconds;
+    snapshot->minutes      = sceneInfo.minutes;
+    snapshot->timeEnabled  = sceneInfo.timeEnabled;
+    snapshot->randSeed     = randSeed;
+    snapshot->valid        = true;
+
+    return true;
+}
+
+bool32 RSDK::RestoreSceneSnapshot()
+{
+    SceneSnapshot *snapshot = &sceneSnapshot;
+    if (!snapshot->valid)
+        return false;
+
+    snapshot->restorePending = true;
+    return true;
+}
+
+void RSDK::ProcessSceneSnapshotRestore()
+{
+    SceneSnapshot *snapshot = &sceneSnapshot;
+    if (!snapshot->restorePending)
+        return;
+
+    snapshot->restorePending = false;
+    if (!snapshot->valid)
+        return;
+
+    memset(objectEntityList, 0, ENTITY_COUNT * sizeof(EntityBase));
+    EntityBase *entity = snapshot->entities;
+    for (int32 w = 0; w < ENTITYCLASS_INDEX_WORDS; ++w) {
+        for (uint32 bits = snapshot->usedSlots[w]; bits; bits &= bits - 1)
+            memcpy(&objectEntityList[(w << 5) + CountTrailingZeros(bits)], entity++, sizeof(EntityBase));
+    }
+
+    for (int32 l = 0; l < LAYER_COUNT; ++l) {
+        TileLayer *layer = &tileLayers[l];
+
+        // the buffers themselves stay where they are, only their contents get restored
+        uint16 *layout    = layer->layout;
+        uint8 *lineScroll = layer->lineScroll;
+        memcpy(layer, &snapshot->layers[l], sizeof(TileLayer));
+        layer->layout     = layout;
+        layer->lineScroll = lineScroll;
+
+        if (layout && snapshot->layouts[l]) {
+            memcpy(layout, snapshot->layouts[l], sizeof(uint16) * (1 << layer->widthShift) * (1 << layer->heightShift));
+        }
+
+        if (lineScroll && snapshot->lineScrolls[l])
+            memcpy(lineScroll, snapshot->lineScrolls[l], TILE_SIZE * MAX(layer->xsize, layer->ysize));
+    }
+
+    uint8 *staticVars = snapshot->staticVars;
+    for (int32 o = 0; o < sceneInfo.classCount; ++o) {
+        ObjectClass *classInfo = &objectClassList[stageObjectIDs[o]];
+        if (staticVars && classInfo->staticVars && *classInfo->staticVars) {
+            memcpy(*classInfo->staticVars, staticVars, classInfo->staticClassSize);
+            staticVars += classInfo->staticClassSize;
+        }
+    }
+
+    memcpy(fullPalette, snapshot->fullPalette, sizeof(fullPalette));
+    memcpy(gfxLineBuffer, snapshot->lineBuffer, SCREEN_YSIZE * sizeof(uint8));
+    memcpy(cameras, snapshot->cameras, sizeof(cameras));
+    cameraCount            = snapshot->cameraCount;
+    sceneInfo.entitySlot   = snapshot->entitySlot;
+    sceneInfo.createSlot   = snapshot->createSlot;
+    sceneInfo.timeCounter  = snapshot->timeCounter;
+    sceneInfo.milliseconds = snapshot->milliseconds;
+    sceneInfo.seconds      = snapshot->seconds;
+    sceneInfo.minutes      = snapshot->minutes;
+    sceneInfo.timeEnabled  = snapshot->timeEnabled;
+    randSeed               = snapshot->randSeed;
+
+    // the lists that point at entities get rebuilt the same way they would be after a load
+    for (int32 i = 0; i < DRAWGROUP_COUNT; ++i) drawGroups[i].entityCount = 0;
+    for (int32 i = 0; i < TYPEGROUP_COUNT; ++i) typeGroups[i].entryCount = 0;
+    InvalidateEntityGrid();
+    RebuildEntityClassIndex();
+}
+
+void RSDK::ClearSceneSnapshot()
+{
+    SceneSnapshot *snapshot = &sceneSnapshot;
+
+    if (snapshot->entities)
+        RemoveStorageEntry((void **)&snapshot->entities);
+    for (int32 l = 0; l < LAYER_COUNT; ++l) {
+        if (snapshot->layouts[l])
+            RemoveStorageEntry((void **)&snapshot->layouts[l]);
+        if (snapshot->lineScrolls[l])
+            RemoveStorageEntry((void **)&snapshot->lineScrolls[l]);
+    }
+    if (snapshot->staticVars)
+        RemoveStorageEntry((void **)&snapshot->staticVars);
+
+    snapshot->entities   = NULL;
+    snapshot->staticVars = NULL;
+    memset(snapshot->layouts, 0, sizeof(snapshot->layouts));
+    memset(snapshot->lineScrolls, 0, sizeof(snapshot->lineScrolls));
+    snapshot->valid          = false;
+    snapshot->restorePending = false;
+}
+#endif
+
 void RSDK::CopyTileLayer(uint16 dstLayerID, int32 dstStartX, int32 dstStartY, uint16 srcLayerID, int32 srcStartX, int32 srcStartY, int32 countX,
                          int32 countY)
 {
@@ -1348,21 +1837,99 @@ void RSDK::CopyTileLayer(uint16 dstLayerID, int32 dstStartX, int32 dstStartY, ui
     }
 }
 
-void RSDK::DrawLayerHScroll(TileLayer *layer)
+#if RETRO_USE_THREADS
+struct LayerBandInfo {
+    TileLayer *layer;
+    ScreenInfo *screen;
+    ScanlineInfo *scanlines;
+    uint8 *lineBuffer;
+    uint16 (*palette)[PALETTE_BANK_SIZE];
+    int32 start;
+    int32 end;
+    int32 size;
+};
+
+static void DrawLayerBand(void *data, int32 bandID)
+{
+    LayerBandInfo *info = (LayerBandInfo *)data;
+
+    int32 start = info->start + bandID * info->size;
+    int32 end   = MIN(start + info->size, info->end);
+    if (start >= end)
+        return;
+
+    // bands may run on any thread, so take on the drawing thread's context first
+    currentScreen = info->screen;
+    scanlines     = info->scanlines;
+    gfxLineBuffer = info->lineBuffer;
+    layerPalette  = info->palette;
+
+    switch (info->layer->type) {
+        case LAYER_HSCROLL: DrawLayerHScroll(info->layer, start, end); break;
+        case LAYER_VSCROLL: DrawLayerVScroll(info->layer, start, end); break;
+        case LAYER_ROTOZOOM: DrawLayerRotozoom(info->layer, start, end); break;
+        default: break;
+    }
+}
+#endif
+
+void RSDK::DrawLayer(TileLayer *layer)
+{
+#if RETRO_USE_THREADS
+    // each band only writes its own lines (or columns for vscroll layers) so the result matches a single threaded draw
+    // basic layers step through tiles across the whole clip area at once, so they're always drawn in one go
+    int32 bandCount = workerThreadCount + 1;
+    if (bandCount > 1 && layer->type != LAYER_BASIC) {
+        LayerBandInfo info;
+        info.layer      = layer;
+        info.screen     = currentScreen;
+        info.scanlines  = scanlines;
+        info.lineBuffer = gfxLineBuffer;
+        info.palette    = layerPalette;
+
+        if (layer->type == LAYER_VSCROLL) {
+            info.start = currentScreen->clipBound_X1;
+            info.end   = currentScreen->clipBound_X2;
+        }
+        else {
+            info.start = currentScreen->clipBound_Y1;
+            info.end   = currentScreen->clipBound_Y2;
+        }
+
+        // rotozoom layers are drawn 2 lines at a time, so bands are kept to an even size
+        int32 length = info.end - info.start;
+        info.size    = (((length + bandCount - 1) / bandCount) + 1) & ~1;
+
+        if (length > 0)
+            RunWorkerJobs(DrawLayerBand, &info, bandCount);
+        return;
+    }
+#endif
+
+    switch (layer->type) {
+        case LAYER_HSCROLL: DrawLayerHScroll(layer, currentScreen->clipBound_Y1, currentScreen->clipBound_Y2); break;
+        case LAYER_VSCROLL: DrawLayerVScroll(layer, currentScreen->clipBound_X1, currentScreen->clipBound_X2); break;
+        case LAYER_ROTOZOOM: DrawLayerRotozoom(layer, currentScreen->clipBound_Y1, currentScreen->clipBound_Y2); break;
+        case LAYER_BASIC: DrawLayerBasic(layer); break;
+        default: break;
+    }
+}
+
+void RSDK::DrawLayerHScroll(TileLayer *layer, int32 startY, int32 endY)
 {
     if (!layer->xsize || !layer->ysize)
         return;
 
     int32 lineTileCount    = (currentScreen->pitch >> 4) - 1;
-    uint8 *lineBuffer      = &gfxLineBuffer[currentScreen->clipBound_Y1];
-    ScanlineInfo *scanline = &scanlines[currentScreen->clipBound_Y1];
-    uint16 *frameBuffer    = &currentScreen->frameBuffer[currentScreen->pitch * currentScreen->clipBound_Y1];
+    uint8 *lineBuffer      = &gfxLineBuffer[startY];
+    ScanlineInfo *scanline = &scanlines[startY];
+    uint16 *frameBuffer    = &currentScreen->frameBuffer[currentScreen->pitch * startY];
 
-    for (int32 cy = currentScreen->clipBound_Y1; cy < currentScreen->clipBound_Y2; ++cy) {
+    for (int32 cy = startY; cy < endY; ++cy) {
         int32 x               = scanline->position.x;
         int32 y               = scanline->position.y;
         int32 tileX           = FROM_FIXED(x);
-        uint16 *activePalette = fullPalette[*lineBuffer++];
+        uint16 *activePalette = layerPalette[*lineBuffer++];
 
         if (tileX >= TILE_SIZE * layer->xsize)
             x = TO_FIXED(tileX - TILE_SIZE * layer->xsize);
@@ -1402,69 +1969,7 @@ void RSDK::DrawLayerHScroll(TileLayer *layer)
             if (*layout < 0xFFFF) {
                 uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + sheetY];
 
-                uint8 index = *pixels;
-                if (index)
-                    *frameBuffer = activePalette[index];
-
-                index = pixels[1];
-                if (index)
-                    frameBuffer[1] = activePalette[index];
-
-                index = pixels[2];
-                if (index)
-                    frameBuffer[2] = activePalette[index];
-
-                index = pixels[3];
-                if (index)
-                    frameBuffer[3] = activePalette[index];
-
-                index = pixels[4];
-                if (index)
-                    frameBuffer[4] = activePalette[index];
-
-                index = pixels[5];
-                if (index)
-                    frameBuffer[5] = activePalette[index];
-
-                index = pixels[6];
-                if (index)
-                    frameBuffer[6] = activePalette[index];
-
-                index = pixels[7];
-                if (index)
-                    frameBuffer[7] = activePalette[index];
-
-                index = pixels[8];
-                if (index)
-                    frameBuffer[8] = activePalette[index];
-
-                index = pixels[9];
-                if (index)
-                    frameBuffer[9] = activePalette[index];
-
-                index = pixels[10];
-                if (index)
-                    frameBuffer[10] = activePalette[index];
-
-                index = pixels[11];
-                if (index)
-                    frameBuffer[11] = activePalette[index];
-
-                index = pixels[12];
-                if (index)
-                    frameBuffer[12] = activePalette[index];
-
-                index = pixels[13];
-                if (index)
-                    frameBuffer[13] = activePalette[index];
-
-                index = pixels[14];
-                if (index)
-                    frameBuffer[14] = activePalette[index];
-
-                index = pixels[15];
-                if (index)
-                    frameBuffer[15] = activePalette[index];
+                DrawTileRow(frameBuffer, pixels, activePalette);
             }
 
             frameBuffer += TILE_SIZE;
@@ -1500,17 +2005,17 @@ void RSDK::DrawLayerHScroll(TileLayer *layer)
         ++scanline;
     }
 }
-void RSDK::DrawLayerVScroll(TileLayer *layer)
+void RSDK::DrawLayerVScroll(TileLayer *layer, int32 startX, int32 endX)
 {
     if (!layer->xsize || !layer->ysize)
         return;
 
     int32 lineTileCount    = (currentScreen->size.y >> 4) - 1;
-    uint16 *frameBuffer    = &currentScreen->frameBuffer[currentScreen->clipBound_X1];
-    ScanlineInfo *scanline = &scanlines[currentScreen->clipBound_X1];
-    uint16 *activePalette  = fullPalette[gfxLineBuffer[0]];
+    uint16 *frameBuffer    = &currentScreen->frameBuffer[startX];
+    ScanlineInfo *scanline = &scanlines[startX];
+    uint16 *activePalette  = layerPalette[gfxLineBuffer[0]];
 
-    for (int32 cx = currentScreen->clipBound_X1; cx < currentScreen->clipBound_X2; ++cx) {
+    for (int32 cx = startX; cx < endX; ++cx) {
         int32 x  = scanline->position.x;
         int32 y  = scanline->position.y;
         int32 ty = FROM_FIXED(y);
@@ -1642,15 +2147,143 @@ void RSDK::DrawLayerVScroll(TileLayer *layer)
         ++frameBuffer;
     }
 }
-void RSDK::DrawLayerRotozoom(TileLayer *layer)
+void RSDK::DrawRotozoomLine_Scalar(uint16 *frameBuffer, const uint16 *palette, int32 count, int32 posX, int32 posY, int32 deformX, int32 deformY,
+                                   const RotozoomLineInfo *info)
+{
+    // neighbouring pixels usually land on the same tile, so only look the tile up again when it changes
+    int32 prevTileID   = -1;
+    uint8 *tilePixels = NULL;
+    for (int32 x = 0; x < count; ++x) {
+        int32 tileID = ((posX >> 20) & info->widthMask) + (((posY >> 20) & info->heightMask) << info->widthShift);
+        if (tileID != prevTileID) {
+            prevTileID = tileID;
+            tilePixels = &tilesetPixels[(info->layout[tileID] & 0xFFF) << 8];
+        }
+
+        uint8 index = tilePixels[((posX >> 16) & 0xF) + (((posY >> 16) & 0xF) << 4)];
+        if (index)
+            frameBuffer[x] = palette[index];
+
+        posX += deformX;
+        posY += deformY;
+    }
+}
+
+#if RETRO_USE_SSE2
+void RSDK::DrawRotozoomLine_SSE2(uint16 *frameBuffer, const uint16 *palette, int32 count, int32 posX, int32 posY, int32 deformX, int32 deformY,
+                                 const RotozoomLineInfo *info)
+{
+    const __m128i widthMask  = _mm_set1_epi32(info->widthMask);
+    const __m128i heightMask = _mm_set1_epi32(info->heightMask);
+    const __m128i texelMask  = _mm_set1_epi32(0xF);
+    const __m128i widthShift = _mm_cvtsi32_si128(info->widthShift);
+    const __m128i stepX      = _mm_set1_epi32(deformX * 4);
+    const __m128i stepY      = _mm_set1_epi32(deformY * 4);
+
+    __m128i lanePosX = _mm_add_epi32(_mm_set1_epi32(posX), _mm_setr_epi32(0, deformX, deformX * 2, deformX * 3));
+    __m128i lanePosY = _mm_add_epi32(_mm_set1_epi32(posY), _mm_setr_epi32(0, deformY, deformY * 2, deformY * 3));
+
+    int32 x = 0;
+    for (; x + 8 <= count; x += 8) {
+        int32 tileIDs[8];
+        int32 texels[8];
+        for (int32 h = 0; h < 8; h += 4) {
+            __m128i tileX = _mm_and_si128(_mm_srai_epi32(lanePosX, 20), widthMask);
+            __m128i tileY = _mm_and_si128(_mm_srai_epi32(lanePosY, 20), heightMask);
+            _mm_storeu_si128((__m128i *)&tileIDs[h], _mm_add_epi32(tileX, _mm_sll_epi32(tileY, widthShift)));
+
+            __m128i texelX = _mm_and_si128(_mm_srai_epi32(lanePosX, 16), texelMask);
+            __m128i texelY = _mm_and_si128(_mm_srai_epi32(lanePosY, 16), texelMask);
+            _mm_storeu_si128((__m128i *)&texels[h], _mm_or_si128(texelX, _mm_slli_epi32(texelY, 4)));
+
+            lanePosX = _mm_add_epi32(lanePosX, stepX);
+            lanePosY = _mm_add_epi32(lanePosY, stepY);
+        }
+
+        // there's no 16-bit gather, so the tile, texel & palette lookups stay scalar
+        uint16 colors[8];
+        uint16 mask[8];
+        uint8 opaque = 0;
+        for (int32 i = 0; i < 8; ++i) {
+            uint8 index = tilesetPixels[((info->layout[tileIDs[i]] & 0xFFF) << 8) + texels[i]];
+            colors[i]   = palette[index];
+            mask[i]     = index ? 0xFFFF : 0x0000;
+            opaque |= index;
+        }
+
+        if (opaque) {
+            __m128i drawMask = _mm_loadu_si128((const __m128i *)mask);
+            __m128i dst      = _mm_loadu_si128((const __m128i *)&frameBuffer[x]);
+            __m128i src      = _mm_loadu_si128((const __m128i *)colors);
+            _mm_storeu_si128((__m128i *)&frameBuffer[x], _mm_or_si128(_mm_and_si128(drawMask, src), _mm_andnot_si128(drawMask, dst)));
+        }
+    }
+
+    if (x < count)
+        DrawRotozoomLine_Scalar(&frameBuffer[x], palette, count - x, posX + deformX * x, posY + deformY * x, deformX, deformY, info);
+}
+#endif
+
+#if RETRO_USE_NEON
+void RSDK::DrawRotozoomLine_NEON(uint16 *frameBuffer, const uint16 *palette, int32 count, int32 posX, int32 posY, int32 deformX, int32 deformY,
+                                 const RotozoomLineInfo *info)
+{
+    const int32x4_t widthMask  = vdupq_n_s32(info->widthMask);
+    const int32x4_t heightMask = vdupq_n_s32(info->heightMask);
+    const int32x4_t texelMask  = vdupq_n_s32(0xF);
+    const int32x4_t widthShift = vdupq_n_s32(info->widthShift);
+    const int32x4_t stepX      = vdupq_n_s32(deformX * 4);
+    const int32x4_t stepY      = vdupq_n_s32(deformY * 4);
+
+    const int32 laneSteps[4] = { 0, 1, 2, 3 };
+    int32x4_t lanePosX       = vmlaq_n_s32(vdupq_n_s32(posX), vld1q_s32(laneSteps), deformX);
+    int32x4_t lanePosY       = vmlaq_n_s32(vdupq_n_s32(posY), vld1q_s32(laneSteps), deformY);
+
+    int32 x = 0;
+    for (; x + 8 <= count; x += 8) {
+        int32 tileIDs[8];
+        int32 texels[8];
+        for (int32 h = 0; h < 8; h += 4) {
+            int32x4_t tileX = vandq_s32(vshrq_n_s32(lanePosX, 20), widthMask);
+            int32x4_t tileY = vandq_s32(vshrq_n_s32(lanePosY, 20), heightMask);
+            vst1q_s32(&tileIDs[h], vaddq_s32(tileX, vshlq_s32(tileY, widthShift)));
+
+            int32x4_t texelX = vandq_s32(vshrq_n_s32(lanePosX, 16), texelMask);
+            int32x4_t texelY = vandq_s32(vshrq_n_s32(lanePosY, 16), texelMask);
+            vst1q_s32(&texels[h], vorrq_s32(texelX, vshlq_n_s32(texelY, 4)));
+
+            lanePosX = vaddq_s32(lanePosX, stepX);
+            lanePosY = vaddq_s32(lanePosY, stepY);
+        }
+
+        uint16 colors[8];
+        uint16 mask[8];
+        uint8 opaque = 0;
+        for (int32 i = 0; i < 8; ++i) {
+            uint8 index = tilesetPixels[((info->layout[tileIDs[i]] & 0xFFF) << 8) + texels[i]];
+            colors[i]   = palette[index];
+            mask[i]     = index ? 0xFFFF : 0x0000;
+            opaque |= index;
+        }
+
+        if (opaque)
+            vst1q_u16(&frameBuffer[x], vbslq_u16(vld1q_u16(mask), vld1q_u16(colors), vld1q_u16(&frameBuffer[x])));
+    }
+
+    if (x < count)
+        DrawRotozoomLine_Scalar(&frameBuffer[x], palette, count - x, posX + deformX * x, posY + deformY * x, deformX, deformY, info);
+}
+#endif
+
+void RSDK::DrawLayerRotozoom(TileLayer *layer, int32 startY, int32 endY)
 {
     if (!layer->xsize || !layer->ysize)
         return;
 
     uint16 *layout = layer->layout;
-    uint8 *lineBuffer = &gfxLineBuffer[currentScreen->clipBound_Y1];
-    ScanlineInfo *scanline = &scanlines[currentScreen->clipBound_Y1];
-    uint16 *frameBuffer = &currentScreen->frameBuffer[currentScreen->clipBound_X1 + currentScreen->clipBound_Y1 * currentScreen->pitch];
+    uint8 *lineBuffer = &gfxLineBuffer[startY];
+    ScanlineInfo *scanline = &scanlines[startY];
+    uint16 *frameBuffer = &currentScreen->frameBuffer[currentScreen->clipBound_X1 + startY * currentScreen->pitch];
 
     int32 width = (TILE_SIZE << layer->widthShift) - 1;
     int32 height = (TILE_SIZE << layer->heightShift) - 1;
@@ -1660,12 +2293,45 @@ void RSDK::DrawLayerRotozoom(TileLayer *layer)
     int32 heightMask = height >> 4;
     int32 widthShift = layer->widthShift;
 
-    for (int32 cy = currentScreen->clipBound_Y1; cy < currentScreen->clipBound_Y2; cy += 2) {
+#if !RETRO_USE_ORIGINAL_CODE
+    int32 quality = customSettings.rotozoomQuality;
+#else
+    int32 quality = ROTOZOOM_HALFRES;
+#endif
+
+    if (quality != ROTOZOOM_HALFRES) {
+        RotozoomLineInfo info;
+        info.layout     = layout;
+        info.widthMask  = widthMask;
+        info.heightMask = heightMask;
+        info.widthShift = widthShift;
+
+        void (*drawLine)(uint16 *frameBuffer, const uint16 *palette, int32 count, int32 posX, int32 posY, int32 deformX, int32 deformY,
+                         const RotozoomLineInfo *info) = DrawRotozoomLine_Scalar;
+#if RETRO_USE_SSE2
+        if (quality == ROTOZOOM_FULLRES_SIMD)
+            drawLine = DrawRotozoomLine_SSE2;
+#elif RETRO_USE_NEON
+        if (quality == ROTOZOOM_FULLRES_SIMD)
+            drawLine = DrawRotozoomLine_NEON;
+#endif
+
+        for (int32 cy = startY; cy < endY; ++cy) {
+            drawLine(frameBuffer, layerPalette[*lineBuffer++], lineSize, scanline->position.x, scanline->position.y, scanline->deform.x,
+                     scanline->deform.y, &info);
+
+            ++scanline;
+            frameBuffer += currentScreen->pitch;
+        }
+        return;
+    }
+
+    for (int32 cy = startY; cy < endY; cy += 2) {
         int32 posX = scanline->position.x;
         int32 posY = scanline->position.y;
         int32 deformX = scanline->deform.x;
         int32 deformY = scanline->deform.y;
-        uint16 *activePalette = fullPalette[*lineBuffer];
+        uint16 *activePalette = layerPalette[*lineBuffer];
         
         lineBuffer += 2;
         scanline += 2;
@@ -1674,7 +2340,8 @@ void RSDK::DrawLayerRotozoom(TileLayer *layer)
         int32 tempPosY = posY;
         
         uint16 *fb1 = frameBuffer;
-        uint16 *fb2 = frameBuffer + currentScreen->pitch;
+        // an odd line count leaves the last block half outside of the draw area
+        uint16 *fb2 = cy + 1 < endY ? frameBuffer + currentScreen->pitch : fb1;
         
         for (int32 cx = 0; cx < lineSize; cx += 2) {
             int32 tx = (tempPosX >> 20) & widthMask;
@@ -1709,7 +2376,7 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
     if (currentScreen->clipBound_X1 >= currentScreen->clipBound_X2 || currentScreen->clipBound_Y1 >= currentScreen->clipBound_Y2)
         return;
 
-    uint16 *activePalette = fullPalette[0];
+    uint16 *activePalette = layerPalette[0];
     if (currentScreen->clipBound_X1 < currentScreen->clipBound_X2 && currentScreen->clipBound_Y1 < currentScreen->clipBound_Y2) {
         int32 lineSize = (currentScreen->clipBound_X2 - currentScreen->clipBound_X1) >> 4;
 
@@ -1760,69 +2427,7 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
                 else {
                     uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + TILE_SIZE * sheetY];
                     for (int32 y = 0; y < tileRemainY; ++y) {
-                        uint8 index = *pixels;
-                        if (index)
-                            *frameBuffer = activePalette[index];
-
-                        index = pixels[1];
-                        if (index)
-                            frameBuffer[1] = activePalette[index];
-
-                        index = pixels[2];
-                        if (index)
-                            frameBuffer[2] = activePalette[index];
-
-                        index = pixels[3];
-                        if (index)
-                            frameBuffer[3] = activePalette[index];
-
-                        index = pixels[4];
-                        if (index)
-                            frameBuffer[4] = activePalette[index];
-
-                        index = pixels[5];
-                        if (index)
-                            frameBuffer[5] = activePalette[index];
-
-                        index = pixels[6];
-                        if (index)
-                            frameBuffer[6] = activePalette[index];
-
-                        index = pixels[7];
-                        if (index)
-                            frameBuffer[7] = activePalette[index];
-
-                        index = pixels[8];
-                        if (index)
-                            frameBuffer[8] = activePalette[index];
-
-                        index = pixels[9];
-                        if (index)
-                            frameBuffer[9] = activePalette[index];
-
-                        index = pixels[10];
-                        if (index)
-                            frameBuffer[10] = activePalette[index];
-
-                        index = pixels[11];
-                        if (index)
-                            frameBuffer[11] = activePalette[index];
-
-                        index = pixels[12];
-                        if (index)
-                            frameBuffer[12] = activePalette[index];
-
-                        index = pixels[13];
-                        if (index)
-                            frameBuffer[13] = activePalette[index];
-
-                        index = pixels[14];
-                        if (index)
-                            frameBuffer[14] = activePalette[index];
-
-                        index = pixels[15];
-                        if (index)
-                            frameBuffer[15] = activePalette[index];
+                        DrawTileRow(frameBuffer, pixels, activePalette);
 
                         frameBuffer += currentScreen->pitch;
                         pixels += TILE_SIZE;
@@ -1908,69 +2513,7 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
                     uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF)];
 
                     for (int32 y = 0; y < TILE_SIZE; ++y) {
-                        uint8 index = *pixels;
-                        if (index)
-                            *frameBuffer = activePalette[index];
-
-                        index = pixels[1];
-                        if (index)
-                            frameBuffer[1] = activePalette[index];
-
-                        index = pixels[2];
-                        if (index)
-                            frameBuffer[2] = activePalette[index];
-
-                        index = pixels[3];
-                        if (index)
-                            frameBuffer[3] = activePalette[index];
-
-                        index = pixels[4];
-                        if (index)
-                            frameBuffer[4] = activePalette[index];
-
-                        index = pixels[5];
-                        if (index)
-                            frameBuffer[5] = activePalette[index];
-
-                        index = pixels[6];
-                        if (index)
-                            frameBuffer[6] = activePalette[index];
-
-                        index = pixels[7];
-                        if (index)
-                            frameBuffer[7] = activePalette[index];
-
-                        index = pixels[8];
-                        if (index)
-                            frameBuffer[8] = activePalette[index];
-
-                        index = pixels[9];
-                        if (index)
-                            frameBuffer[9] = activePalette[index];
-
-                        index = pixels[10];
-                        if (index)
-                            frameBuffer[10] = activePalette[index];
-
-                        index = pixels[11];
-                        if (index)
-                            frameBuffer[11] = activePalette[index];
-
-                        index = pixels[12];
-                        if (index)
-                            frameBuffer[12] = activePalette[index];
-
-                        index = pixels[13];
-                        if (index)
-                            frameBuffer[13] = activePalette[index];
-
-                        index = pixels[14];
-                        if (index)
-                            frameBuffer[14] = activePalette[index];
-
-                        index = pixels[15];
-                        if (index)
-                            frameBuffer[15] = activePalette[index];
+                        DrawTileRow(frameBuffer, pixels, activePalette);
 
                         pixels += TILE_SIZE;
                         frameBuffer += currentScreen->pitch;
@@ -2059,69 +2602,7 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
                 else {
                     uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF)];
                     for (int32 y = 0; y < sheetY; ++y) {
-                        uint8 index = *pixels;
-                        if (index)
-                            *frameBuffer = activePalette[index];
-
-                        index = pixels[1];
-                        if (index)
-                            frameBuffer[1] = activePalette[index];
-
-                        index = pixels[2];
-                        if (index)
-                            frameBuffer[2] = activePalette[index];
-
-                        index = pixels[3];
-                        if (index)
-                            frameBuffer[3] = activePalette[index];
-
-                        index = pixels[4];
-                        if (index)
-                            frameBuffer[4] = activePalette[index];
-
-                        index = pixels[5];
-                        if (index)
-                            frameBuffer[5] = activePalette[index];
-
-                        index = pixels[6];
-                        if (index)
-                            frameBuffer[6] = activePalette[index];
-
-                        index = pixels[7];
-                        if (index)
-                            frameBuffer[7] = activePalette[index];
-
-                        index = pixels[8];
-                        if (index)
-                            frameBuffer[8] = activePalette[index];
-
-                        index = pixels[9];
-                        if (index)
-                            frameBuffer[9] = activePalette[index];
-
-                        index = pixels[10];
-                        if (index)
-                            frameBuffer[10] = activePalette[index];
-
-                        index = pixels[11];
-                        if (index)
-                            frameBuffer[11] = activePalette[index];
-
-                        index = pixels[12];
-                        if (index)
-                            frameBuffer[12] = activePalette[index];
-
-                        index = pixels[13];
-                        if (index)
-                            frameBuffer[13] = activePalette[index];
-
-                        index = pixels[14];
-                        if (index)
-                            frameBuffer[14] = activePalette[index];
-
-                        index = pixels[15];
-                        if (index)
-                            frameBuffer[15] = activePalette[index];
+                        DrawTileRow(frameBuffer, pixels, activePalette);
 
                         pixels += TILE_SIZE;
                         frameBuffer += currentScreen->pitch;
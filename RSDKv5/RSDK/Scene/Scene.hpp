@@ -146,7 +146,7 @@ struct TileInfo {
     uint8 flag;
 };
 
-extern ScanlineInfo *scanlines;
+extern RETRO_THREAD_LOCAL ScanlineInfo *scanlines;
 extern TileLayer tileLayers[LAYER_COUNT];
 
 extern CollisionMask collisionMasks[CPATH_COUNT][TILE_COUNT * 4]; // 1024 * 1 per direction
@@ -175,6 +175,11 @@ void ProcessParallax(TileLayer *layer);
 void ProcessSceneTimer();
 
 void SetScene(const char *categoryName, const char *sceneName);
+#if !RETRO_USE_ORIGINAL_CODE
+// starts reading the scene's StageConfig, TileConfig, tileset & layout files in the background (a bit each frame), so the load that
+// eventually goes to that scene gets them from memory. anything that isn't used by the next load is thrown away once it's done
+void PreloadScene(const char *categoryName, const char *sceneName);
+#endif
 inline void LoadScene()
 {
     if ((sceneInfo.state & ENGINESTATE_STEPOVER) == ENGINESTATE_STEPOVER)
@@ -183,6 +188,44 @@ inline void LoadScene()
         sceneInfo.state = ENGINESTATE_LOAD;
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+// a copy of the scene's runtime state (entities, layouts, static vars, palettes, cameras & the timer), so it can be put back without going
+// through LoadSceneFolder/LoadSceneAssets. anything the copied state points to (sprites, storage etc) isn't copied & has to still be loaded
+struct SceneSnapshot {
+    uint32 usedSlots[ENTITYCLASS_INDEX_WORDS];
+    EntityBase *entities; // only the slots set in usedSlots, packed in slot order
+    TileLayer layers[LAYER_COUNT];
+    uint16 *layouts[LAYER_COUNT];
+    uint8 *lineScrolls[LAYER_COUNT];
+    uint8 *staticVars;
+    uint16 fullPalette[PALETTE_BANK_COUNT][PALETTE_BANK_SIZE];
+    uint8 lineBuffer[SCREEN_YSIZE];
+    CameraInfo cameras[CAMERA_COUNT];
+    int32 cameraCount;
+    int32 entitySlot;
+    int32 createSlot;
+    int32 timeCounter;
+    uint8 milliseconds;
+    uint8 seconds;
+    uint8 minutes;
+    bool32 timeEnabled;
+    uint32 randSeed;
+    bool32 valid;
+    bool32 restorePending;
+};
+
+extern SceneSnapshot sceneSnapshot;
+
+// both return false if there's nothing to use (no memory for the copy or no snapshot of the current scene)
+bool32 CaptureSceneSnapshot();
+// the restore is queued & only happens once the current frame is done, so it can't pull entities out from under an update pass
+bool32 RestoreSceneSnapshot();
+// applies a queued restore, called at the end of every frame
+void ProcessSceneSnapshotRestore();
+// releases the copy, this happens on its own whenever a scene gets loaded
+void ClearSceneSnapshot();
+#endif
+
 #if RETRO_REV02
 inline void ForceHardReset(bool32 shouldHardReset) { forceHardReset = shouldHardReset; }
 #endif
@@ -311,12 +354,59 @@ inline void CopyTile(uint16 dest, uint16 src, uint16 count)
 
 inline ScanlineInfo *GetScanlines() { return scanlines; }
 
-// Draw a layer with horizonal scrolling capabilities
-void DrawLayerHScroll(TileLayer *layer);
-// Draw a layer with vertical scrolling capabilities
-void DrawLayerVScroll(TileLayer *layer);
-// Draw a layer with rotozoom (via scanline callback) capabilities
-void DrawLayerRotozoom(TileLayer *layer);
+// draws one full 16px tile row, index 0 pixels are left untouched
+extern void (*DrawTileRow)(uint16 *frameBuffer, const uint8 *pixels, const uint16 *palette);
+
+void DrawTileRow_Scalar(uint16 *frameBuffer, const uint8 *pixels, const uint16 *palette);
+#if RETRO_USE_SSE2
+void DrawTileRow_SSE2(uint16 *frameBuffer, const uint8 *pixels, const uint16 *palette);
+#endif
+#if RETRO_USE_NEON
+void DrawTileRow_NEON(uint16 *frameBuffer, const uint8 *pixels, const uint16 *palette);
+#endif
+// picks the DrawTileRow kernel for the instruction set the engine was built with, see BenchmarkTileRows
+void InitTileRowKernels();
+#if !RETRO_USE_ORIGINAL_CODE
+// times every DrawTileRow kernel the cpu supports against the scalar one on synthetic layouts
+void BenchmarkTileRows();
+#endif
+
+enum RotozoomQualities {
+    ROTOZOOM_HALFRES,      // 2x2 blocks, only every other scanline & pixel is sampled
+    ROTOZOOM_FULLRES,      // every pixel is sampled
+    ROTOZOOM_FULLRES_SIMD, // every pixel is sampled, texel addresses are computed 8 pixels at a time
+};
+
+// full res is opt-in, the layout/tileset lookups can't be vectorised so it still costs about twice the half res path
+#define DEFAULT_ROTOZOOM_QUALITY (ROTOZOOM_HALFRES)
+
+struct RotozoomLineInfo {
+    uint16 *layout;
+    int32 widthMask;
+    int32 heightMask;
+    int32 widthShift;
+};
+
+// draws count pixels of one rotozoom layer scanline, index 0 pixels are left untouched
+void DrawRotozoomLine_Scalar(uint16 *frameBuffer, const uint16 *palette, int32 count, int32 posX, int32 posY, int32 deformX, int32 deformY,
+                             const RotozoomLineInfo *info);
+#if RETRO_USE_SSE2
+void DrawRotozoomLine_SSE2(uint16 *frameBuffer, const uint16 *palette, int32 count, int32 posX, int32 posY, int32 deformX, int32 deformY,
+                           const RotozoomLineInfo *info);
+#endif
+#if RETRO_USE_NEON
+void DrawRotozoomLine_NEON(uint16 *frameBuffer, const uint16 *palette, int32 count, int32 posX, int32 posY, int32 deformX, int32 deformY,
+                           const RotozoomLineInfo *info);
+#endif
+
+// Draw a layer using the draw function for its type, split into bands across the worker threads when they're enabled
+void DrawLayer(TileLayer *layer);
+// Draw lines startY to endY of a layer with horizonal scrolling capabilities
+void DrawLayerHScroll(TileLayer *layer, int32 startY, int32 endY);
+// Draw columns startX to endX of a layer with vertical scrolling capabilities
+void DrawLayerVScroll(TileLayer *layer, int32 startX, int32 endX);
+// Draw lines startY to endY of a layer with rotozoom (via scanline callback) capabilities
+void DrawLayerRotozoom(TileLayer *layer, int32 startY, int32 endY);
 // Draw a "basic" layer, no special capabilities, but it's the fastest to draw
 void DrawLayerBasic(TileLayer *layer);
 
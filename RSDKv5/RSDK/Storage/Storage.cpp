@@ -6,18 +6,302 @@ using namespace RSDK;
 #include "Legacy/UserStorageLegacy.cpp"
 #endif
 
+#if RETRO_USE_STORAGE_TELEMETRY
+#undef AllocateStorage
+#endif
+
 #define HEADER(memory, header_value) memory[-HEADER_SIZE + header_value]
 
 enum {
     HEADER_ACTIVE,      // indicates if the memory block is active
     HEADER_SET_ID,      // dataset identifier
-    HEADER_DATA_OFFSET, // offset to actual data
+    HEADER_ENTRY_ID,    // index of the entry that allocated it
     HEADER_DATA_LENGTH, // length of data in bytes
     HEADER_SIZE         // total header size
 };
 
 DataStorage RSDK::dataStorage[DATASET_MAX];
 
+#if RETRO_USE_STORAGE_SIMULATION
+StorageSimulation RSDK::storageSimulation;
+#endif
+
+uint32 RSDK::gcFrameCounter = 0;
+bool32 RSDK::gcEnabled      = true;
+
+#if RETRO_USE_STORAGE_TELEMETRY
+StorageTelemetry RSDK::storageTelemetry[DATASET_MAX];
+StorageCallSite RSDK::storageCallSites[STORAGE_CALLSITE_COUNT];
+
+static const char *storageSetNames[] = { "STG", "MUS", "SFX", "STR", "TMP" };
+
+#define STORAGE_GC_START() clock_t gcStart = clock()
+#define STORAGE_GC_END(set)                                                                                                                          \
+    storageTelemetry[set].gcTicks += (uint32)(clock() - gcStart);                                                                                    \
+    storageTelemetry[set].gcCount++
+#else
+#define STORAGE_GC_START()
+#define STORAGE_GC_END(set)
+#endif
+
+// what each arena's malloc actually returned, memoryTable is this rounded up to STORAGE_ALIGNMENT
+static void *arenaAllocations[DATASET_MAX];
+// how far each arena's storageLimit can be expanded, in units
+static uint32 arenaSizes[DATASET_MAX];
+
+// arena blocks are [padding][header][data], with the data aligned to STORAGE_ALIGNMENT. the padding only depends on where the block
+// starts, so walking the arena is just repeating this from the end of the previous block
+static inline uint32 GetArenaDataOffset(uint32 blockStart)
+{
+    uint32 align = STORAGE_ALIGNMENT / sizeof(uint32);
+    return (blockStart + HEADER_SIZE + align - 1) & ~(align - 1);
+}
+
+static uint32 *AllocateArenaBlock(DataStorage *storage, StorageDataSets dataSet, uint32 size)
+{
+    uint32 offset = GetArenaDataOffset(storage->usedStorage);
+    if (offset + size / sizeof(uint32) > storage->storageLimit)
+        return NULL;
+
+    uint32 *memory = &storage->memoryTable[offset];
+    HEADER(memory, HEADER_ACTIVE)      = true;
+    HEADER(memory, HEADER_SET_ID)      = dataSet;
+    HEADER(memory, HEADER_ENTRY_ID)    = storage->entryCount;
+    HEADER(memory, HEADER_DATA_LENGTH) = size;
+
+    storage->usedStorage = offset + size / sizeof(uint32);
+    return memory;
+}
+
+// swaps the last entry into the removed one's place, so removal doesn't have to shift anything
+static void RemoveEntry(DataStorage *storage, int32 index)
+{
+    int32 last = --storage->entryCount;
+    if (index != last) {
+        uint32 *moved = storage->storageEntries[last];
+        if (HEADER(moved, HEADER_ENTRY_ID) == (uint32)last)
+            HEADER(moved, HEADER_ENTRY_ID) = index;
+
+        storage->dataEntries[index]    = storage->dataEntries[last];
+        storage->storageEntries[index] = moved;
+        storage->entrySizes[index]     = storage->entrySizes[last];
+#if RETRO_USE_STORAGE_TELEMETRY
+        storage->entrySites[index] = storage->entrySites[last];
+#endif
+    }
+
+    storage->dataEntries[last]    = NULL;
+    storage->storageEntries[last] = NULL;
+    storage->entrySizes[last]     = 0;
+}
+
+// an entry is garbage once whatever it was allocated for stops pointing at it
+static bool32 IsEntryLive(DataStorage *storage, int32 index, uint32 set)
+{
+    uint32 **handle = storage->dataEntries[index];
+    uint32 *data    = storage->storageEntries[index];
+    if (!handle || !data || *handle != data)
+        return false;
+
+    return HEADER(data, HEADER_ACTIVE) && HEADER(data, HEADER_SET_ID) == set;
+}
+
+// CopyStorage registers extra entries for the same block, so a block can only be freed once none of the others are left
+static bool32 IsBlockShared(DataStorage *storage, int32 index)
+{
+    // most sets never have copies, so they don't need searching
+    if (!storage->copyCount)
+        return false;
+
+    uint32 *data = storage->storageEntries[index];
+    for (int32 e = 0; e < storage->entryCount; ++e) {
+        if (e != index && storage->storageEntries[e] == data)
+            return true;
+    }
+
+    return false;
+}
+
+// a copy's header still has the entry id of the entry it was copied from, so that's how they're told apart
+static int32 CountCopies(DataStorage *storage)
+{
+    int32 count = 0;
+    for (int32 e = 0; e < storage->entryCount; ++e) {
+        uint32 *data = storage->storageEntries[e];
+        if (data && HEADER(data, HEADER_ENTRY_ID) != (uint32)e)
+            count++;
+    }
+
+    return count;
+}
+
+static void DropEntry(DataStorage *storage, int32 index)
+{
+    uint32 *data = storage->storageEntries[index];
+    if (data) {
+        // arena blocks stay where they are until the next defrag
+        if (!storage->memoryTable && !IsBlockShared(storage, index)) {
+            storage->usedStorage -= storage->entrySizes[index];
+            free(data - HEADER_SIZE);
+        }
+
+        // null out user pointer if it still points here, it may have been given a new block since
+        if (storage->dataEntries[index] && *storage->dataEntries[index] == data)
+            *storage->dataEntries[index] = NULL;
+    }
+
+    RemoveEntry(storage, index);
+}
+
+// data offsets of the blocks a defrag keeps, before & after the move
+static uint32 compactedFrom[STORAGE_ENTRY_COUNT];
+static uint32 compactedTo[STORAGE_ENTRY_COUNT];
+
+// where something inside one of the kept blocks (or its header) ends up after the defrag, NULL if it's in memory that's being dropped
+static void *GetCompactedAddress(uint32 *arena, int32 blockCount, void *ptr)
+{
+    uint32 pos = (uint32)(((uint8 *)ptr - (uint8 *)arena) / sizeof(uint32)) + HEADER_SIZE;
+
+    int32 b = -1;
+    for (int32 l = 0, r = blockCount - 1; l <= r;) {
+        int32 m = (l + r) >> 1;
+        if (compactedFrom[m] <= pos) {
+            b = m;
+            l = m + 1;
+        }
+        else {
+            r = m - 1;
+        }
+    }
+
+    if (b < 0)
+        return NULL;
+
+    uint32 *data = &arena[compactedFrom[b]];
+    if (pos >= compactedFrom[b] + HEADER_SIZE + HEADER(data, HEADER_DATA_LENGTH) / sizeof(uint32))
+        return NULL;
+
+    return (uint8 *)ptr - (compactedFrom[b] - compactedTo[b]) * sizeof(uint32);
+}
+
+// slides every block that still has a live entry down to the start of the arena, updating the entries & their handles as it goes
+static void CompactArena(DataStorage *storage)
+{
+    uint32 *arena = storage->memoryTable;
+
+    // mark the blocks something still points to
+    for (int32 e = 0; e < storage->entryCount; ++e) {
+        uint32 *data = storage->storageEntries[e];
+        if (storage->dataEntries[e] && *storage->dataEntries[e] == data && HEADER(data, HEADER_ACTIVE))
+            HEADER(data, HEADER_ACTIVE) = 2;
+    }
+
+    // work out where the marked blocks end up
+    int32 blockCount = 0;
+    uint32 newUsed   = 0;
+    for (uint32 pos = 0; pos < storage->usedStorage;) {
+        uint32 offset = GetArenaDataOffset(pos);
+        uint32 *data  = &arena[offset];
+        uint32 length = HEADER(data, HEADER_DATA_LENGTH) / sizeof(uint32);
+        pos           = offset + length;
+
+        if (HEADER(data, HEADER_ACTIVE) == 2) {
+            compactedFrom[blockCount] = offset;
+            compactedTo[blockCount]   = GetArenaDataOffset(newUsed);
+            newUsed                   = compactedTo[blockCount] + length;
+            blockCount++;
+        }
+    }
+
+    // repoint the live entries, anything else is dropped without touching its handle (it isn't pointing here anymore)
+    int32 validCount = 0;
+    for (int32 e = 0; e < storage->entryCount; ++e) {
+        uint32 **handle = storage->dataEntries[e];
+        uint32 *data    = storage->storageEntries[e];
+        if (!handle || *handle != data || HEADER(data, HEADER_ACTIVE) != 2)
+            continue;
+
+        uint32 *moved = (uint32 *)GetCompactedAddress(arena, blockCount, data);
+        *handle       = moved;
+
+        // the handle itself might live in a block that's about to move (or be dropped)
+        if ((uint32 *)handle >= arena && (uint32 *)handle < &arena[storage->usedStorage]) {
+            handle = (uint32 **)GetCompactedAddress(arena, blockCount, handle);
+            if (!handle)
+                continue;
+        }
+
+        // the header moves with the block, so it can be fixed up here
+        if (HEADER(data, HEADER_ENTRY_ID) == (uint32)e)
+            HEADER(data, HEADER_ENTRY_ID) = validCount;
+
+        storage->dataEntries[validCount]    = handle;
+        storage->storageEntries[validCount] = moved;
+        storage->entrySizes[validCount]     = storage->entrySizes[e];
+#if RETRO_USE_STORAGE_TELEMETRY
+        storage->entrySites[validCount] = storage->entrySites[e];
+#endif
+        validCount++;
+    }
+
+    // blocks only ever move down, so moving them front to back never overwrites one that hasn't moved yet
+    for (int32 b = 0; b < blockCount; ++b) {
+        uint32 *data  = &arena[compactedFrom[b]];
+        uint32 *moved = &arena[compactedTo[b]];
+        if (moved != data)
+            memmove(moved - HEADER_SIZE, data - HEADER_SIZE, HEADER_SIZE * sizeof(uint32) + HEADER(data, HEADER_DATA_LENGTH));
+
+        HEADER(moved, HEADER_ACTIVE) = true;
+    }
+
+    for (int32 e = validCount; e < storage->entryCount; ++e) {
+        storage->dataEntries[e]    = NULL;
+        storage->storageEntries[e] = NULL;
+        storage->entrySizes[e]     = 0;
+    }
+
+    storage->entryCount  = validCount;
+    storage->usedStorage = newUsed;
+    storage->gcCursor    = 0;
+    storage->clearCount++;
+}
+
+// nulls every handle still pointing into the set & frees each malloc'd block once, even if CopyStorage gave it more than one entry
+static void ReleaseEntries(DataStorage *storage)
+{
+    // the last entry for a block is the one that frees it, so that's marked (& the handles cleared) before anything is freed
+    for (int32 e = 0; e < storage->entryCount; ++e) {
+        uint32 *data = storage->storageEntries[e];
+        if (!data)
+            continue;
+
+        if (storage->dataEntries[e] && *storage->dataEntries[e] == data)
+            *storage->dataEntries[e] = NULL;
+
+        if (!storage->memoryTable)
+            HEADER(data, HEADER_ENTRY_ID) = e;
+    }
+
+    if (!storage->memoryTable) {
+        for (int32 e = 0; e < storage->entryCount; ++e) {
+            uint32 *data = storage->storageEntries[e];
+            if (data && HEADER(data, HEADER_ENTRY_ID) == (uint32)e)
+                free(data - HEADER_SIZE);
+        }
+    }
+
+    for (int32 e = 0; e < STORAGE_ENTRY_COUNT; ++e) {
+        storage->dataEntries[e]    = NULL;
+        storage->storageEntries[e] = NULL;
+        storage->entrySizes[e]     = 0;
+    }
+
+    storage->usedStorage = 0;
+    storage->entryCount  = 0;
+    storage->gcCursor    = 0;
+    storage->copyCount   = 0;
+}
+
 bool32 RSDK::InitStorage()
 {
     // initialize all storage datasets
@@ -27,6 +311,9 @@ bool32 RSDK::InitStorage()
         dataStorage[s].storageLimit = 0;
         dataStorage[s].entryCount = 0;
         dataStorage[s].clearCount = 0;
+        dataStorage[s].dirtyCount = 0;
+        dataStorage[s].gcCursor = 0;
+        dataStorage[s].copyCount = 0;
 
         // set memory limits for each dataset type
         switch (s) {
@@ -42,6 +329,29 @@ bool32 RSDK::InitStorage()
             default:
                 dataStorage[s].storageLimit = (4 * 1024 * 1024) / sizeof(uint32);    // 4mb default
         }
+
+#if RETRO_USE_STORAGE_SIMULATION
+        if (storageSimulation.setLimits[s])
+            dataStorage[s].storageLimit = storageSimulation.setLimits[s] / sizeof(uint32);
+#endif
+
+        arenaAllocations[s] = NULL;
+        arenaSizes[s]       = 0;
+        if ((STORAGE_ARENA_SETS >> s) & 1) {
+            // reserved at the most it could ever be expanded to, so big stages can still go over the default limit
+            arenaSizes[s] = MAX(dataStorage[s].storageLimit, STORAGE_LIMIT_MAX / sizeof(uint32));
+#if RETRO_USE_STORAGE_SIMULATION
+            if (storageSimulation.setLimits[s])
+                arenaSizes[s] = dataStorage[s].storageLimit;
+#endif
+            arenaAllocations[s] = malloc(arenaSizes[s] * sizeof(uint32) + STORAGE_ALIGNMENT);
+
+            // if it can't be reserved up front this set just mallocs each entry instead
+            if (arenaAllocations[s])
+                dataStorage[s].memoryTable = (uint32 *)(((size_t)arenaAllocations[s] + STORAGE_ALIGNMENT - 1) & ~(size_t)(STORAGE_ALIGNMENT - 1));
+            else
+                PrintLog(PRINT_NORMAL, "Failed to reserve a %d byte arena for dataset %d", arenaSizes[s] * sizeof(uint32), s);
+        }
         
         // clear all entry arrays
         for (int32 e = 0; e < STORAGE_ENTRY_COUNT; ++e) {
@@ -58,35 +368,17 @@ void RSDK::ReleaseStorage()
 {
     // release all datasets and free their memory
     for (int32 s = 0; s < DATASET_MAX; ++s) {
-        // free all entries in this dataset
-        for (int32 e = 0; e < dataStorage[s].entryCount; ++e) {
-            if (dataStorage[s].storageEntries[e] != NULL) {
-                uint32 *data = (uint32 *)dataStorage[s].storageEntries[e];
-                uint32 *header = data - HEADER_SIZE;
-                free(header);
-                
-                // null out the user's pointer if it exists
-                if (dataStorage[s].dataEntries[e] != NULL) {
-                    *dataStorage[s].dataEntries[e] = NULL;
-                }
-            }
-        }
+        ReleaseEntries(&dataStorage[s]);
 
         // reset dataset state
+        if (arenaAllocations[s])
+            free(arenaAllocations[s]);
+        arenaAllocations[s]        = NULL;
         dataStorage[s].memoryTable = NULL;
-        dataStorage[s].usedStorage = 0;
         dataStorage[s].storageLimit = 0;
-        dataStorage[s].entryCount = 0;
         dataStorage[s].clearCount = 0;
-        
-        // clear all entry arrays
-        for (int32 e = 0; e < STORAGE_ENTRY_COUNT; ++e) {
-            dataStorage[s].dataEntries[e] = NULL;
-            dataStorage[s].storageEntries[e] = NULL;
-            dataStorage[s].entrySizes[e] = 0;
-        }
+        dataStorage[s].dirtyCount = 0;
     }
-
 #if !RETRO_USE_ORIGINAL_CODE
     // free data pack buffers if not using original code
     for (int32 p = 0; p < dataPackCount; ++p) {
@@ -97,6 +389,41 @@ void RSDK::ReleaseStorage()
 #endif
 }
 
+#if RETRO_USE_STORAGE_SIMULATION
+// decides whether an allocation is allowed to go ahead under the simulated limits
+static bool32 SimulateAllocation(StorageDataSets dataSet, uint32 size)
+{
+    StorageSimulation *sim = &storageSimulation;
+
+    if (sim->failEvery && ((sim->failSets >> dataSet) & 1) && !(++sim->allocCounter % sim->failEvery)) {
+        sim->failCount++;
+        PrintLog(PRINT_NORMAL, "Storage simulation: failing allocation %d (%d bytes in dataset %d)", sim->allocCounter, size, dataSet);
+        return false;
+    }
+
+    if (sim->totalLimit) {
+        uint32 required = size + HEADER_SIZE * sizeof(uint32);
+        uint32 total    = 0;
+        for (int32 s = 0; s < DATASET_MAX; ++s) total += dataStorage[s].usedStorage * sizeof(uint32);
+
+        // same as running out of a single set, clear out what this one can before giving up
+        if (total + required > sim->totalLimit) {
+            total -= dataStorage[dataSet].usedStorage * sizeof(uint32);
+            DefragmentAndGarbageCollectStorage(dataSet);
+            total += dataStorage[dataSet].usedStorage * sizeof(uint32);
+        }
+
+        if (total + required > sim->totalLimit) {
+            sim->failCount++;
+            PrintLog(PRINT_NORMAL, "Storage simulation: %d bytes in dataset %d would go over the %d byte limit", size, dataSet, sim->totalLimit);
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
 void RSDK::AllocateStorage(void **dataPtr, uint32 size, StorageDataSets dataSet, bool32 clear)
 {
     uint32 **data = (uint32 **)dataPtr;
@@ -112,6 +439,44 @@ void RSDK::AllocateStorage(void **dataPtr, uint32 size, StorageDataSets dataSet,
     
     DataStorage *storage = &dataStorage[dataSet];
 
+#if RETRO_USE_STORAGE_SIMULATION
+    if (!SimulateAllocation(dataSet, size))
+        return;
+#endif
+
+    if (storage->memoryTable) {
+        // the block's header records its entry index, so there has to be a free entry before anything is bumped
+        if (storage->entryCount >= STORAGE_ENTRY_COUNT) {
+            GarbageCollectStorage(dataSet);
+            if (storage->entryCount >= STORAGE_ENTRY_COUNT)
+                return;
+        }
+
+        // compact what's left first, the limit is only raised if that still isn't enough
+        uint32 *memory = AllocateArenaBlock(storage, dataSet, size);
+        if (!memory) {
+            DefragmentAndGarbageCollectStorage(dataSet);
+            memory = AllocateArenaBlock(storage, dataSet, size);
+        }
+
+        if (!memory && ExpandStorage(dataSet, size + STORAGE_ALIGNMENT + HEADER_SIZE * sizeof(uint32)))
+            memory = AllocateArenaBlock(storage, dataSet, size);
+
+        if (!memory)
+            return;
+
+        *data = memory;
+        if (clear)
+            memset(*data, 0, size);
+
+        storage->dirtyCount++;
+        storage->dataEntries[storage->entryCount]    = data;
+        storage->storageEntries[storage->entryCount] = *data;
+        storage->entrySizes[storage->entryCount]     = size / sizeof(uint32) + HEADER_SIZE;
+        storage->entryCount++;
+        return;
+    }
+
     // check memory limit
     uint32 totalSize = (HEADER_SIZE * sizeof(uint32)) + size;
     uint32 totalSizeInUnits = totalSize / sizeof(uint32);
@@ -146,7 +511,7 @@ void RSDK::AllocateStorage(void **dataPtr, uint32 size, StorageDataSets dataSet,
     // setup header information
     memory[HEADER_ACTIVE] = true;
     memory[HEADER_SET_ID] = dataSet;
-    memory[HEADER_DATA_OFFSET] = HEADER_SIZE;
+    memory[HEADER_ENTRY_ID] = storage->entryCount;
     memory[HEADER_DATA_LENGTH] = size;
 
     // point to data after header
@@ -164,6 +529,7 @@ void RSDK::AllocateStorage(void **dataPtr, uint32 size, StorageDataSets dataSet,
     storage->entrySizes[entryIndex] = totalSizeInUnits;
     storage->entryCount++;
     storage->usedStorage += totalSizeInUnits;
+    storage->dirtyCount++;
 
     // run garbage collection if over 75% capacity
     if ((float)storage->usedStorage / (float)storage->storageLimit > 0.75f) {
@@ -192,12 +558,15 @@ void RSDK::RemoveStorageEntry(void **dataPtr)
     // mark as inactive
     header[HEADER_ACTIVE] = false;
 
-    // find entry in storage list
-    int32 foundIdx = -1;
-    for (int32 e = 0; e < storage->entryCount; ++e) {
-        if (storage->storageEntries[e] == data) {
-            foundIdx = e;
-            break;
+    // find entry in storage list, copies don't own the header so they still need looking for
+    int32 foundIdx = header[HEADER_ENTRY_ID];
+    if (foundIdx < 0 || foundIdx >= storage->entryCount || storage->storageEntries[foundIdx] != data) {
+        foundIdx = -1;
+        for (int32 e = 0; e < storage->entryCount; ++e) {
+            if (storage->storageEntries[e] == data) {
+                foundIdx = e;
+                break;
+            }
         }
     }
 
@@ -206,23 +575,15 @@ void RSDK::RemoveStorageEntry(void **dataPtr)
         uint32 dataSize = header[HEADER_DATA_LENGTH];
         uint32 totalSize = (HEADER_SIZE * sizeof(uint32)) + dataSize;
         uint32 totalSizeInUnits = totalSize / sizeof(uint32);
-        
-        storage->usedStorage -= totalSizeInUnits;
-        
-        free(header);
 
-        // shift remaining entries down
-        for (int32 e = foundIdx; e < storage->entryCount - 1; ++e) {
-            storage->dataEntries[e] = storage->dataEntries[e + 1];
-            storage->storageEntries[e] = storage->storageEntries[e + 1];
-            storage->entrySizes[e] = storage->entrySizes[e + 1];
+        // arena blocks are only reclaimed by a defrag, & shared ones are freed once the GC has dropped the other (now inactive) entries
+        if (!storage->memoryTable && !IsBlockShared(storage, foundIdx)) {
+            storage->usedStorage -= totalSizeInUnits;
+
+            free(header);
         }
-        
-        // clear last entry
-        storage->entryCount--;
-        storage->dataEntries[storage->entryCount] = NULL;
-        storage->storageEntries[storage->entryCount] = NULL;
-        storage->entrySizes[storage->entryCount] = 0;
+
+        RemoveEntry(storage, foundIdx);
     }
 
     // null out user's pointer
@@ -231,8 +592,14 @@ void RSDK::RemoveStorageEntry(void **dataPtr)
 
 void RSDK::DefragmentAndGarbageCollectStorage(StorageDataSets set)
 {
-    // currently just calls garbage collection
-    GarbageCollectStorage(set);
+    if ((uint32)set < DATASET_MAX && dataStorage[set].memoryTable) {
+        STORAGE_GC_START();
+        CompactArena(&dataStorage[set]);
+        STORAGE_GC_END(set);
+    }
+    else {
+        GarbageCollectStorage(set);
+    }
 }
 
 void RSDK::CopyStorage(uint32 **src, uint32 **dst)
@@ -261,7 +628,12 @@ void RSDK::CopyStorage(uint32 **src, uint32 **dst)
         storage->dataEntries[storage->entryCount] = src;
         storage->storageEntries[storage->entryCount] = *src;
         storage->entrySizes[storage->entryCount] = (header[HEADER_DATA_LENGTH] + (HEADER_SIZE * sizeof(uint32))) / sizeof(uint32);
+#if RETRO_USE_STORAGE_TELEMETRY
+        storage->entrySites[storage->entryCount] = 0;
+#endif
         storage->entryCount++;
+        storage->dirtyCount++;
+        storage->copyCount++;
     }
 }
 
@@ -273,74 +645,60 @@ void RSDK::GarbageCollectStorage(StorageDataSets set)
     }
 
     DataStorage *storage = &dataStorage[set];
-    
-    int32 validCount = 0;
-    uint32 freedMemory = 0;
-    
-    // temporary arrays to hold valid entries
-    uint32 **validDataEntries[STORAGE_ENTRY_COUNT];
-    uint32 *validStorageEntries[STORAGE_ENTRY_COUNT];
-    uint32 validEntrySizes[STORAGE_ENTRY_COUNT];
-    
-    // scan all entries and separate valid from invalid
-    for (int32 e = 0; e < storage->entryCount; ++e) {
-        bool32 isValid = false;
-        
-        // check if entry is still valid
-        if (storage->dataEntries[e] != NULL && storage->storageEntries[e] != NULL) {
-            uint32 *userPtr = *storage->dataEntries[e];
-            
-            // verify pointer still points to our storage and header is valid
-            if (userPtr != NULL && userPtr == storage->storageEntries[e]) {
-                uint32 *header = userPtr - HEADER_SIZE;
-                if (header[HEADER_ACTIVE] && header[HEADER_SET_ID] == set) {
-                    isValid = true;
-                }
-            }
-        }
-        
-        // keep valid entries, free invalid ones
-        if (isValid) {
-            validDataEntries[validCount] = storage->dataEntries[e];
-            validStorageEntries[validCount] = storage->storageEntries[e];
-            validEntrySizes[validCount] = storage->entrySizes[e];
-            validCount++;
-        }
-        else {
-            // free invalid entry
-            if (storage->storageEntries[e] != NULL) {
-                uint32 *data = storage->storageEntries[e];
-                uint32 *header = data - HEADER_SIZE;
-                
-                freedMemory += storage->entrySizes[e];
-                free(header);
-                
-                // null out user pointer if it exists
-                if (storage->dataEntries[e] != NULL) {
-                    *storage->dataEntries[e] = NULL;
-                }
-            }
-        }
+    STORAGE_GC_START();
+
+    for (int32 e = 0; e < storage->entryCount;) {
+        if (IsEntryLive(storage, e, set))
+            ++e;
+        else
+            DropEntry(storage, e);
     }
-    
-    // copy valid entries back to main arrays
-    for (int32 e = 0; e < validCount; ++e) {
-        storage->dataEntries[e] = validDataEntries[e];
-        storage->storageEntries[e] = validStorageEntries[e];
-        storage->entrySizes[e] = validEntrySizes[e];
+
+    storage->dirtyCount = 0;
+    storage->gcCursor   = 0;
+    storage->copyCount  = CountCopies(storage);
+    storage->clearCount++;
+    STORAGE_GC_END(set);
+}
+
+void RSDK::CollectStorageGarbage(StorageDataSets set, int32 budget)
+{
+    if ((uint32)set >= DATASET_MAX)
+        return;
+
+    DataStorage *storage = &dataStorage[set];
+
+    // a pass is only started when something could've been orphaned since the last one
+    if (!storage->gcCursor) {
+        if (!storage->dirtyCount)
+            return;
+        storage->dirtyCount = 0;
     }
-    
-    // clear remaining entries
-    for (int32 e = validCount; e < STORAGE_ENTRY_COUNT; ++e) {
-        storage->dataEntries[e] = NULL;
-        storage->storageEntries[e] = NULL;
-        storage->entrySizes[e] = 0;
+
+#if RETRO_USE_STORAGE_TELEMETRY
+    clock_t gcStart = clock();
+#endif
+
+    // dropped entries get the last one swapped in, so the cursor only moves past live ones
+    while (budget-- > 0 && storage->gcCursor < storage->entryCount) {
+        if (IsEntryLive(storage, storage->gcCursor, set))
+            storage->gcCursor++;
+        else
+            DropEntry(storage, storage->gcCursor);
+    }
+
+#if RETRO_USE_STORAGE_TELEMETRY
+    storageTelemetry[set].gcTicks += (uint32)(clock() - gcStart);
+#endif
+
+    if (storage->gcCursor >= storage->entryCount) {
+        storage->gcCursor  = 0;
+        storage->copyCount = CountCopies(storage);
+        storage->clearCount++;
+#if RETRO_USE_STORAGE_TELEMETRY
+        storageTelemetry[set].gcCount++;
+#endif
     }
-    
-    // update storage state
-    storage->entryCount = validCount;
-    storage->usedStorage -= freedMemory;
-    storage->clearCount++;
 }
 
 void RSDK::EmergencyStorageCleanup(StorageDataSets set)
@@ -350,32 +708,18 @@ void RSDK::EmergencyStorageCleanup(StorageDataSets set)
         return;
     }
     
+    // free all entries & reset storage state
+    ReleaseEntries(&dataStorage[set]);
+}
+
+void RSDK::ResetStorage(StorageDataSets set)
+{
+    if ((uint32)set >= DATASET_MAX)
+        return;
+
     DataStorage *storage = &dataStorage[set];
-    
-    // free all entries
-    for (int32 e = 0; e < storage->entryCount; ++e) {
-        if (storage->storageEntries[e] != NULL) {
-            uint32 *data = storage->storageEntries[e];
-            uint32 *header = data - HEADER_SIZE;
-            free(header);
-            
-            // null out user pointer
-            if (storage->dataEntries[e] != NULL) {
-                *storage->dataEntries[e] = NULL;
-            }
-        }
-    }
-    
-    // reset storage state
-    storage->usedStorage = 0;
-    storage->entryCount = 0;
-    
-    // clear all arrays
-    for (int32 e = 0; e < STORAGE_ENTRY_COUNT; ++e) {
-        storage->dataEntries[e] = NULL;
-        storage->storageEntries[e] = NULL;
-        storage->entrySizes[e] = 0;
-    }
+    ReleaseEntries(storage);
+    storage->clearCount++;
 }
 
 bool32 RSDK::ExpandStorage(StorageDataSets dataSet, uint32 requiredSize)
@@ -386,9 +730,18 @@ bool32 RSDK::ExpandStorage(StorageDataSets dataSet, uint32 requiredSize)
     }
     
     DataStorage *storage = &dataStorage[dataSet];
+
+#if RETRO_USE_STORAGE_SIMULATION
+    // a simulated limit is meant to be hit
+    if (storageSimulation.setLimits[dataSet]) {
+        return false;
+    }
+#endif
     
-    // ps2 has a total 32mb ram limit
-    uint32 maxLimit = (32 * 1024 * 1024) / sizeof(uint32);
+    // ps2 has a total 32mb ram limit, arenas can only use what they reserved
+    uint32 maxLimit = STORAGE_LIMIT_MAX / sizeof(uint32);
+    if (storage->memoryTable)
+        maxLimit = arenaSizes[dataSet];
     
     // try to expand by double the required size
     uint32 newLimit = storage->storageLimit + (requiredSize / sizeof(uint32)) * 2;
@@ -409,29 +762,181 @@ bool32 RSDK::ExpandStorage(StorageDataSets dataSet, uint32 requiredSize)
 }
 
 // new functions (maintain compatibility)
-void RSDK::SetGCEnabled(bool32 enabled) 
+void RSDK::SetGCEnabled(bool32 enabled) { gcEnabled = enabled; }
+
+void RSDK::UpdateStorageGC()
 {
-    // simple implementation placeholder
+    gcFrameCounter++;
+
+    if (!gcEnabled)
+        return;
+
+    // a little bit every frame rather than a full sweep of everything every second
+    for (int32 s = 0; s < DATASET_MAX; ++s) CollectStorageGarbage((StorageDataSets)s, STORAGE_GC_FRAME_BUDGET);
 }
 
-void RSDK::UpdateStorageGC()
+void RSDK::PrintStorageStatus()
 {
-    static uint32 frameCounter = 0;
-    frameCounter++;
-    
-    // run garbage collection every second (at 60fps)
-    if (frameCounter >= 60) {
-        for (int32 s = 0; s < DATASET_MAX; ++s) {
-            // only gc if there are many entries
-            if (dataStorage[s].entryCount > 10) {
-                GarbageCollectStorage((StorageDataSets)s);
-            }
+    for (int32 s = 0; s < DATASET_MAX; ++s) {
+        DataStorage *storage = &dataStorage[s];
+#if RETRO_USE_STORAGE_TELEMETRY
+        StorageTelemetry *telemetry = &storageTelemetry[s];
+        PrintLog(PRINT_NORMAL, "%s: %dkb/%dkb used (peak %dkb), %d entries (peak %d), %d allocs (%d failed), %d gcs in %.2fms", storageSetNames[s],
+                 storage->usedStorage / 0x100, storage->storageLimit / 0x100, telemetry->peakStorage / 0x100, storage->entryCount,
+                 telemetry->peakEntries, telemetry->allocCount, telemetry->failedCount, telemetry->gcCount,
+                 telemetry->gcTicks * 1000.0f / CLOCKS_PER_SEC);
+#else
+        PrintLog(PRINT_NORMAL, "Dataset %d: %dkb/%dkb used, %d entries", s, storage->usedStorage / 0x100, storage->storageLimit / 0x100,
+                 storage->entryCount);
+#endif
+    }
+}
+
+#if RETRO_USE_STORAGE_TELEMETRY
+void RSDK::AllocateStorageAt(void **dataPtr, uint32 size, StorageDataSets dataSet, bool32 clear, const char *file, int32 line)
+{
+    AllocateStorage(dataPtr, size, dataSet, clear);
+    if ((uint32)dataSet >= DATASET_MAX)
+        return;
+
+    DataStorage *storage        = &dataStorage[dataSet];
+    StorageTelemetry *telemetry = &storageTelemetry[dataSet];
+    if (!*dataPtr) {
+        telemetry->failedCount++;
+        return;
+    }
+
+    telemetry->allocCount++;
+    telemetry->peakStorage = MAX(telemetry->peakStorage, storage->usedStorage);
+    telemetry->peakEntries = MAX(telemetry->peakEntries, storage->entryCount);
+
+    int32 bucket = 0;
+    while (bucket < STORAGE_HISTOGRAM_COUNT - 1 && size > (0x10u << bucket)) ++bucket;
+    telemetry->histogram[bucket]++;
+
+    // sites are hashed on file & line, anything that doesn't fit is left as site 0 & isn't reported
+    uint32 hash = ((uint32)(size_t)file ^ ((uint32)line * 0x9E3779B1)) % (STORAGE_CALLSITE_COUNT - 1);
+    int32 site  = 0;
+    for (int32 i = 0; i < STORAGE_CALLSITE_COUNT - 1; ++i) {
+        StorageCallSite *entry = &storageCallSites[1 + (hash + i) % (STORAGE_CALLSITE_COUNT - 1)];
+        if (!entry->file) {
+            entry->file    = file;
+            entry->line    = line;
+            entry->dataSet = dataSet;
+        }
+
+        if (entry->file == file && entry->line == line && entry->dataSet == dataSet) {
+            site = (int32)(entry - storageCallSites);
+            break;
         }
-        frameCounter = 0;
     }
+
+    if (site) {
+        storageCallSites[site].allocCount++;
+        storageCallSites[site].allocBytes += size;
+    }
+
+    uint32 *data                                       = *(uint32 **)dataPtr;
+    storage->entrySites[HEADER(data, HEADER_ENTRY_ID)] = site;
 }
 
-void RSDK::PrintStorageStatus()
+int32 RSDK::GetTopStorageCallSites(StorageDataSets set, int32 *sites, int32 count)
 {
-    // implementation removed
-}
\ No newline at end of file
+    int32 found = 0;
+    for (int32 i = 1; i < STORAGE_CALLSITE_COUNT; ++i) {
+        StorageCallSite *site = &storageCallSites[i];
+        if (site->dataSet != set || !site->allocCount)
+            continue;
+
+        // insertion sort into the (tiny) output list
+        int32 pos = found < count ? found++ : count;
+        while (pos > 0 && storageCallSites[sites[pos - 1]].allocBytes < site->allocBytes) {
+            if (pos < count)
+                sites[pos] = sites[pos - 1];
+            --pos;
+        }
+
+        if (pos < count)
+            sites[pos] = i;
+    }
+
+    return found;
+}
+
+void RSDK::DumpStorageTelemetry(const char *sceneFolder)
+{
+    PrintStorageStatus();
+
+    // the csv is only written with the dev menu enabled, & starts over each run so it doesn't grow forever
+    static bool32 dumpStarted = false;
+    FileIO *file              = NULL;
+    if (engine.devMenu) {
+        char path[0x100];
+        sprintf_s(path, sizeof(path), "%sstorage.csv", SKU::userFileDir);
+        file        = fOpen(path, dumpStarted ? "a" : "w");
+        dumpStarted = true;
+    }
+
+    // rows are one of:
+    // set,scene,set,usedBytes,peakBytes,limitBytes,entries,peakEntries,allocs,failedAllocs,gcs,gcMs,<histogram buckets from <=16b up>
+    // site,scene,set,file,line,allocs,bytes
+    // live,scene,set,file,line,entries,bytes (entries from a site used this scene that are still around after it was unloaded)
+    char row[0x200];
+    for (int32 s = 0; s < DATASET_MAX && file; ++s) {
+        DataStorage *storage        = &dataStorage[s];
+        StorageTelemetry *telemetry = &storageTelemetry[s];
+
+        int32 len = sprintf_s(row, sizeof(row), "set,%s,%s,%u,%u,%u,%d,%d,%u,%u,%u,%.2f", sceneFolder, storageSetNames[s],
+                              (uint32)(storage->usedStorage * sizeof(uint32)), (uint32)(telemetry->peakStorage * sizeof(uint32)),
+                              (uint32)(storage->storageLimit * sizeof(uint32)), storage->entryCount, telemetry->peakEntries, telemetry->allocCount,
+                              telemetry->failedCount, telemetry->gcCount, telemetry->gcTicks * 1000.0f / CLOCKS_PER_SEC);
+        for (int32 b = 0; b < STORAGE_HISTOGRAM_COUNT; ++b) len += sprintf_s(&row[len], sizeof(row) - len, ",%u", telemetry->histogram[b]);
+        sprintf_s(&row[len], sizeof(row) - len, "\n");
+        fWrite(row, 1, strlen(row), file);
+
+        int32 topSites[STORAGE_TOP_CALLSITES];
+        int32 topCount = GetTopStorageCallSites((StorageDataSets)s, topSites, STORAGE_TOP_CALLSITES);
+        for (int32 i = 0; i < topCount; ++i) {
+            StorageCallSite *site = &storageCallSites[topSites[i]];
+            sprintf_s(row, sizeof(row), "site,%s,%s,%s,%d,%u,%u\n", sceneFolder, storageSetNames[s], site->file ? site->file : "?", site->line,
+                      site->allocCount, site->allocBytes);
+            fWrite(row, 1, strlen(row), file);
+        }
+
+        for (int32 i = 1; i < STORAGE_CALLSITE_COUNT; ++i) {
+            StorageCallSite *site = &storageCallSites[i];
+            if (site->dataSet != s || !site->allocCount)
+                continue;
+
+            int32 liveCount = 0;
+            uint32 liveSize = 0;
+            for (int32 e = 0; e < storage->entryCount; ++e) {
+                if (storage->entrySites[e] == i) {
+                    liveCount++;
+                    liveSize += storage->entrySizes[e] * sizeof(uint32);
+                }
+            }
+
+            if (liveCount) {
+                sprintf_s(row, sizeof(row), "live,%s,%s,%s,%d,%d,%u\n", sceneFolder, storageSetNames[s], site->file ? site->file : "?", site->line,
+                          liveCount, liveSize);
+                fWrite(row, 1, strlen(row), file);
+            }
+        }
+    }
+
+    if (file)
+        fClose(file);
+
+    for (int32 s = 0; s < DATASET_MAX; ++s) {
+        memset(&storageTelemetry[s], 0, sizeof(StorageTelemetry));
+        storageTelemetry[s].peakStorage = dataStorage[s].usedStorage;
+        storageTelemetry[s].peakEntries = dataStorage[s].entryCount;
+    }
+
+    for (int32 i = 0; i < STORAGE_CALLSITE_COUNT; ++i) {
+        storageCallSites[i].allocCount = 0;
+        storageCallSites[i].allocBytes = 0;
+    }
+}
+#endif
@@ -1,10 +1,45 @@
 #ifndef STORAGE_H
 #define STORAGE_H
 
+#include <new>
+#include <type_traits>
+#include <utility>
+
 namespace RSDK
 {
 #define STORAGE_ENTRY_COUNT (0x1000)
 
+// how many entries per dataset UpdateStorageGC checks each frame
+#define STORAGE_GC_FRAME_BUDGET (0x40)
+
+#if RETRO_USE_STORAGE_TELEMETRY
+// allocation sizes are counted in power of two buckets, from 16 bytes or less up to anything over 128kb
+#define STORAGE_HISTOGRAM_COUNT (15)
+#define STORAGE_CALLSITE_COUNT  (0x100)
+// how many of the biggest call sites per dataset are shown/dumped
+#define STORAGE_TOP_CALLSITES (6)
+#endif
+
+// datasets in this mask get one preallocated region (sized to their limit) that entries are bump allocated from & that the GC compacts,
+// instead of a malloc per entry. set it to 0 to go back to malloc for everything
+// arenas can't grow past their limit & reserve all of it up front, which ps2 can't afford (and it needs STG to expand), so it mallocs
+#ifndef STORAGE_ARENA_SETS
+#if RETRO_PLATFORM == RETRO_PS2
+#define STORAGE_ARENA_SETS (0)
+#else
+#define STORAGE_ARENA_SETS ((1 << DATASET_STG) | (1 << DATASET_TMP))
+#endif
+#endif
+
+// no dataset's limit can be expanded past this (ps2 has 32mb of ram in total). arenas reserve this much address space up front so they can
+// still grow with ExpandStorage, their limit only decides how much of it gets used
+#define STORAGE_LIMIT_MAX (32 * 1024 * 1024)
+
+// what arena entries are aligned to, in bytes (a multiple of 16)
+#ifndef STORAGE_ALIGNMENT
+#define STORAGE_ALIGNMENT (16)
+#endif
+
 // dataset type identifiers for different storage categories
 enum StorageDataSets {
     DATASET_STG = 0, // stage data
@@ -17,16 +52,43 @@ enum StorageDataSets {
 
 // manages memory allocation for a single dataset
 struct DataStorage {
-    uint32 *memoryTable;                             // pointer to memory table (legacy)
-    uint32 usedStorage;                              // current memory usage in units
+    uint32 *memoryTable;                             // the arena, NULL if entries are malloc'd one by one
+    uint32 usedStorage;                              // current memory usage in units (the bump position for arenas)
     uint32 storageLimit;                             // maximum allowed memory in units
     uint32 **dataEntries[STORAGE_ENTRY_COUNT];       // user pointers to allocated data
     uint32 *storageEntries[STORAGE_ENTRY_COUNT];     // internal pointers to allocated blocks
     uint32 entrySizes[STORAGE_ENTRY_COUNT];          // size of each entry in units
-    uint32 entryCount;                               // number of active entries
+    int32 entryCount;                                // number of active entries
     uint32 clearCount;                               // number of garbage collections performed
+    uint32 dirtyCount;                               // entries added since the last collection pass started
+    int32 gcCursor;                                  // where the incremental collector is up to, 0 between passes
+    int32 copyCount;                                 // entries that share another's block (via CopyStorage) as of the last full pass
+#if RETRO_USE_STORAGE_TELEMETRY
+    uint16 entrySites[STORAGE_ENTRY_COUNT];          // call site each entry was allocated from
+#endif
 };
 
+#if RETRO_USE_STORAGE_TELEMETRY
+// everything here but the call site list is reset after each scene's dump
+struct StorageTelemetry {
+    uint32 peakStorage; // in units, like usedStorage
+    int32 peakEntries;
+    uint32 allocCount;
+    uint32 failedCount;
+    uint32 histogram[STORAGE_HISTOGRAM_COUNT];
+    uint32 gcCount;
+    uint32 gcTicks; // clock() ticks spent collecting/defragmenting
+};
+
+struct StorageCallSite {
+    const char *file;
+    int32 line;
+    uint8 dataSet;
+    uint32 allocCount;
+    uint32 allocBytes;
+};
+#endif
+
 // dynamic array container template
 template <typename T> class List
 {
@@ -34,6 +96,41 @@ template <typename T> class List
     int32 count  = 0;    // current number of elements
     int32 length = 0;    // allocated capacity
 
+    // plain data can just be realloc'd & memmoved, anything else has to be moved element by element
+    static const bool32 trivial = std::is_trivially_copyable<T>::value;
+
+    void Resize(int32 newLength)
+    {
+        T *newEntries = NULL;
+        if (trivial) {
+            newEntries = (T *)realloc(entries, sizeof(T) * newLength);
+            if (!newEntries)
+                return;
+        }
+        else {
+            newEntries = (T *)malloc(sizeof(T) * newLength);
+            if (!newEntries)
+                return;
+
+            for (int32 i = 0; i < count; ++i) {
+                new (&newEntries[i]) T(std::move(entries[i]));
+                entries[i].~T();
+            }
+            free(entries);
+        }
+
+        entries = newEntries;
+        length  = newLength;
+    }
+
+    void DestroyEntries()
+    {
+        if (!trivial) {
+            for (int32 i = 0; i < count; ++i) entries[i].~T();
+        }
+        count = 0;
+    }
+
 public:
     List()
     {
@@ -43,69 +140,86 @@ public:
     ~List()
     {
         if (entries) {
+            DestroyEntries();
             free(entries);
             entries = NULL;
         }
     }
     
+    // makes sure there's room for at least capacity entries without another allocation
+    void Reserve(int32 capacity)
+    {
+        if (capacity > length)
+            Resize(capacity);
+    }
+
     // adds a new entry to the list and returns pointer to it
     T *Append()
     {
-        // expand capacity if needed
+        // expand capacity if needed, doubling it keeps appends amortized O(1)
         if (count == length) {
-            length += 32;
-            size_t len         = sizeof(T) * length;
-            T *entries_realloc = (T *)realloc(entries, len);
-
-            if (entries_realloc) {
-                entries = entries_realloc;
-            }
+            Resize(length ? length * 2 : 32);
+            if (count == length)
+                return NULL;
         }
 
         // initialize new entry
         T *entry = &entries[count];
-        memset(entry, 0, sizeof(T));
+        if (trivial)
+            memset((void *)entry, 0, sizeof(T));
+        else
+            new (entry) T();
         count++;
         return entry;
     }
     
-    // removes entry at specified index
+    // removes entry at specified index, keeping the order of the rest
     void Remove(uint32 index)
     {
+        if ((int32)index >= count)
+            return;
+
         // shift remaining entries down
-        for (int32 i = index; i < count; i++) {
-            if (i + 1 < count) {
-                entries[i] = entries[i + 1];
-            }
-            else { 
-                count--;
-            }
+        if (trivial) {
+            memmove((void *)&entries[index], &entries[index + 1], sizeof(T) * (count - index - 1));
         }
+        else {
+            for (int32 i = index; i < count - 1; ++i) entries[i] = std::move(entries[i + 1]);
+            entries[count - 1].~T();
+        }
+        count--;
+    }
 
-        // shrink capacity if significantly underused
-        if (count < length - 32) {
-            length -= 32;
-            size_t len         = sizeof(T) * length;
-            T *entries_realloc = (T *)realloc(entries, len);
+    // removes entry at specified index by moving the last entry into its place, O(1) but doesn't keep the order
+    void SwapRemove(uint32 index)
+    {
+        if ((int32)index >= count)
+            return;
 
-            if (entries_realloc)
-                entries = entries_realloc;
+        if ((int32)index != count - 1) {
+            if (trivial)
+                memcpy((void *)&entries[index], &entries[count - 1], sizeof(T));
+            else
+                entries[index] = std::move(entries[count - 1]);
         }
+
+        if (!trivial)
+            entries[count - 1].~T();
+        count--;
     }
 
     // returns pointer to entry at index
     inline T *At(int32 index) { return &entries[index]; }
 
-    // removes all entries, optionally deallocating memory
+    // removes all entries, optionally deallocating memory (otherwise the capacity is kept for reuse)
     inline void Clear(bool32 dealloc = false)
     {
-        for (int32 i = count - 1; i >= 0; i--) {
-            Remove(i);
-        }
+        DestroyEntries();
 
         if (entries && dealloc) {
             free(entries);
             entries = NULL;
+            length  = 0;
         }
     }
 
@@ -113,6 +227,20 @@ public:
     inline int32 Count() { return count; }
 };
 
+#if RETRO_USE_STORAGE_SIMULATION
+// set up from the command line before InitStorage, see ParseArguments
+struct StorageSimulation {
+    uint32 setLimits[DATASET_MAX]; // in bytes, 0 keeps the default
+    uint32 totalLimit;             // in bytes, across every dataset, 0 for no limit
+    uint32 failEvery;              // fail every nth allocation from the datasets in failSets, 0 to never
+    uint32 failSets;               // mask of datasets failEvery counts
+    uint32 allocCounter;
+    uint32 failCount;
+};
+
+extern StorageSimulation storageSimulation;
+#endif
+
 // garbage collection state variables
 extern uint32 gcFrameCounter;
 extern bool32 gcEnabled;
@@ -138,6 +266,9 @@ void UpdateStorageGC();
 // forcefully clears all entries in a dataset
 void EmergencyStorageCleanup(StorageDataSets set);
 
+// drops every entry in a dataset, nulling anything still pointing at them & freeing each malloc'd block once
+void ResetStorage(StorageDataSets set);
+
 // prints current storage status (debug only)
 void PrintStorageStatus();
 
@@ -156,6 +287,24 @@ void CopyStorage(uint32 **src, uint32 **dst);
 // performs garbage collection on a dataset
 void GarbageCollectStorage(StorageDataSets dataSet);
 
+// checks at most budget entries for garbage, picking up where the last call left off
+void CollectStorageGarbage(StorageDataSets set, int32 budget);
+
+#if RETRO_USE_STORAGE_TELEMETRY
+extern StorageTelemetry storageTelemetry[DATASET_MAX];
+extern StorageCallSite storageCallSites[STORAGE_CALLSITE_COUNT];
+
+// AllocateStorage, but recorded against the file & line it was called from
+void AllocateStorageAt(void **dataPtr, uint32 size, StorageDataSets dataSet, bool32 clear, const char *file, int32 line);
+#define AllocateStorage(dataPtr, size, dataSet, clear) AllocateStorageAt(dataPtr, size, dataSet, clear, __FILE__, __LINE__)
+
+// fills sites with the call sites that've allocated the most from a dataset since the last dump, returns how many were found
+int32 GetTopStorageCallSites(StorageDataSets set, int32 *sites, int32 count);
+
+// appends this scene's numbers to storage.csv & starts counting afresh
+void DumpStorageTelemetry(const char *sceneFolder);
+#endif
+
 #if RETRO_REV0U
 #include "Legacy/UserStorageLegacy.hpp"
 #endif
@@ -362,7 +362,11 @@ void RSDK::LoadSettingsINI()
         videoSettings.shaderID      = iniparser_getint(ini, "Video:screenShader", SHADER_NONE);
 
 #if !RETRO_USE_ORIGINAL_CODE
-        customSettings.maxPixWidth = iniparser_getint(ini, "Video:maxPixWidth", DEFAULT_PIXWIDTH);
+        customSettings.maxPixWidth     = iniparser_getint(ini, "Video:maxPixWidth", DEFAULT_PIXWIDTH);
+        customSettings.renderThreads   = iniparser_getint(ini, "Video:renderThreads", 0);
+        customSettings.parallelScreens = iniparser_getboolean(ini, "Video:parallelScreens", false);
+        customSettings.faceCulling     = iniparser_getint(ini, "Video:faceCulling", S3D_CULL_NONE);
+        customSettings.rotozoomQuality = iniparser_getint(ini, "Video:rotozoomQuality", DEFAULT_ROTOZOOM_QUALITY);
 #endif
 
         engine.streamsEnabled = iniparser_getboolean(ini, "Audio:streamsEnabled", true);
@@ -522,7 +526,11 @@ void RSDK::LoadSettingsINI()
         sprintf_s(gameLogicName, sizeof(gameLogicName), "Game");
         customSettings.username[0] = 0;
 
-        customSettings.maxPixWidth = DEFAULT_PIXWIDTH;
+        customSettings.maxPixWidth     = DEFAULT_PIXWIDTH;
+        customSettings.renderThreads   = 0;
+        customSettings.parallelScreens = false;
+        customSettings.faceCulling     = S3D_CULL_NONE;
+        customSettings.rotozoomQuality = DEFAULT_ROTOZOOM_QUALITY;
 
         if (customSettings.region >= 0) {
 #if RETRO_REV02
@@ -665,6 +673,15 @@ void RSDK::SaveSettingsINI(bool32 writeToFile)
 #if !RETRO_USE_ORIGINAL_CODE
         WriteText(file, "; Maximum width the screen will be allowed to be. A value of 0 will disable the maximum width\n");
         WriteText(file, "maxPixWidth=%d\n", customSettings.maxPixWidth);
+        WriteText(file, "; Number of threads used for drawing, tile layers are split into bands. A value of 0 or 1 keeps all drawing on the main thread\n");
+        WriteText(file, "renderThreads=%d\n", customSettings.renderThreads);
+        WriteText(file, "; Draws each split screen view on its own render thread. Draw callbacks run draw group by draw group across the screens instead of\n");
+        WriteText(file, "; screen by screen, so objects that share state between screens while drawing may not look the same as without it\n");
+        WriteText(file, "parallelScreens=%s\n", (customSettings.parallelScreens ? "y" : "n"));
+        WriteText(file, "; Skips 3D scene faces before sorting them. 1 = back faces, 2 = faces outside the screen, 3 = both. A value of 0 draws every face\n");
+        WriteText(file, "faceCulling=%d\n", customSettings.faceCulling);
+        WriteText(file, "; Quality of rotozoom layers. 0 = half resolution, 1 = full resolution, 2 = full resolution using SIMD where the cpu supports it\n");
+        WriteText(file, "rotozoomQuality=%d\n", customSettings.rotozoomQuality);
 #endif
 
         // ================
@@ -184,6 +184,10 @@ struct CustomSettings {
     bool32 forceScripts;
 #endif
     int32 maxPixWidth;
+    int32 renderThreads;
+    bool32 parallelScreens;
+    int32 faceCulling;
+    int32 rotozoomQuality;
     char username[0x80];
 };
 
@@ -5,7 +5,7 @@ find_package(PkgConfig REQUIRED)
 
 add_executable(RetroEngine ${RETRO_FILES})
 
-set(RETRO_SUBSYSTEM "OGL" CACHE STRING "The subsystem to use")
+set(RETRO_SUBSYSTEM "OGL" CACHE STRING "The subsystem to use (OGL, VK, SDL2 or HEADLESS)")
 option(USE_SDL_AUDIO "Whether or not to use SDL for audio instead of the default MiniAudio." OFF)
 
 # Some distros like Debian 11 need this to prevent link errors (used by std::thread in Audio devices)
@@ -82,6 +82,9 @@ elseif(RETRO_SUBSYSTEM STREQUAL "SDL2")
     target_link_libraries(RetroEngine ${SDL2_STATIC_LIBRARIES})
     target_link_options(RetroEngine PRIVATE ${SDL2_STATIC_LDLIBS_OTHER})
     target_compile_options(RetroEngine PRIVATE ${SDL2_STATIC_CFLAGS})
+elseif(RETRO_SUBSYSTEM STREQUAL "HEADLESS")
+    # no window or gpu, frames only live in screen memory (optionally dumped to disk)
+    message("building the headless render device")
 endif()
 
 if(NOT RETRO_SUBSYSTEM STREQUAL SDL2)